@@ -0,0 +1,22 @@
+include "Common.lua"
+
+workspace "LuftBenchmarks"
+	BuildPaths()
+	DefinePlatforms()
+	DefineConfigurations()
+	startproject "LuftBenchmarks"
+
+include "Luft.lua"
+
+project "LuftBenchmarks"
+	kind "ConsoleApp"
+	entrypoint "WinMainCRTStartup"
+
+	SetConfigurationSettings()
+	UseWindowsSettings()
+
+	includedirs { "Source" }
+	files { "Source/Benchmarks/**.cpp", "Source/Benchmarks/**.hpp" }
+	links { "Luft" }
+
+	filter {}
@@ -0,0 +1,7 @@
+#include "Benchmarks.hpp"
+
+void Start()
+{
+	RunHashTableBenchmark();
+	RunConcurrentHashTableBenchmark();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Luft/Allocator.hpp"
+#include "Luft/Array.hpp"
+#include "Luft/Error.hpp"
+#include "Luft/Hash.hpp"
+
+template<typename K, typename V>
+class BucketHashTable
+{
+public:
+	explicit BucketHashTable(usize bucketCount, Allocator* allocator = &GlobalAllocator::Get())
+		: Buckets(bucketCount, allocator)
+	{
+		CHECK(bucketCount > 0);
+		for (usize i = 0; i < bucketCount; ++i)
+		{
+			Buckets.Emplace(allocator);
+		}
+	}
+
+	V* Find(const K& key)
+	{
+		Bucket& bucket = Buckets[Hash<K>{}(key) % Buckets.GetCount()];
+		for (Pair& pair : bucket)
+		{
+			if (key == pair.Key)
+			{
+				return &pair.Value;
+			}
+		}
+		return nullptr;
+	}
+
+	bool Add(const K& key, const V& value)
+	{
+		if (V* found = Find(key))
+		{
+			*found = value;
+			return false;
+		}
+
+		Buckets[Hash<K>{}(key) % Buckets.GetCount()].Add(Pair { key, value });
+		return true;
+	}
+
+private:
+	struct Pair
+	{
+		K Key;
+		V Value;
+	};
+
+	using Bucket = Array<Pair>;
+
+	Array<Bucket> Buckets;
+};
@@ -0,0 +1,166 @@
+#include "Benchmarks.hpp"
+
+#include "Luft/Atomic.hpp"
+#include "Luft/Base.hpp"
+#include "Luft/ConcurrentHashTable.hpp"
+#include "Luft/HashTable.hpp"
+#include "Luft/Mutex.hpp"
+#include "Luft/Platform.hpp"
+#include "Luft/Random.hpp"
+
+#include "Luft/WindowsDefine.hpp"
+#include <windows.h>
+#include "Luft/WindowsUndefine.hpp"
+
+#include <stdio.h>
+
+static constexpr usize MaxThreadCount = 64;
+static constexpr uint32 KeyRange = 1 << 20;
+static constexpr usize OperationsPerThread = 1 << 20;
+static constexpr usize CountInterval = 4096;
+
+class LockedHashTable
+{
+public:
+	uint32 Find(uint32 key)
+	{
+		MutexLock lock(&Lock);
+		const uint32* value = Table.Find(key);
+		return value ? *value : 0;
+	}
+
+	uint32 GetOrAdd(uint32 key)
+	{
+		MutexLock lock(&Lock);
+		return Table.GetOrAdd(key);
+	}
+
+	usize GetCount()
+	{
+		MutexLock lock(&Lock);
+		return Table.GetCount();
+	}
+
+private:
+	Mutex Lock;
+	HashTable<uint32, uint32> Table;
+};
+
+class ShardedHashTable
+{
+public:
+	uint32 Find(uint32 key)
+	{
+		const uint32* value = Table.Find(key);
+		return value ? *value : 0;
+	}
+
+	uint32 GetOrAdd(uint32 key)
+	{
+		return Table.GetOrAdd(key);
+	}
+
+	usize GetCount()
+	{
+		return Table.GetCount();
+	}
+
+private:
+	ConcurrentHashTable<uint32, uint32> Table;
+};
+
+template<typename Table>
+struct Worker
+{
+	Table* SharedTable;
+	Atomic<uint32>* ReadyCount;
+	Atomic<uint32>* Go;
+	uint32 Seed;
+	uint32 AddPercentage;
+	uint64 Checksum;
+};
+
+template<typename Table>
+static DWORD WINAPI RunWorker(void* parameter)
+{
+	Worker<Table>* worker = static_cast<Worker<Table>*>(parameter);
+	RandomContext random(worker->Seed);
+
+	worker->ReadyCount->FetchAdd(1);
+	while (worker->Go->Load() == 0)
+	{
+	}
+
+	uint64 checksum = 0;
+	for (usize i = 0; i < OperationsPerThread; ++i)
+	{
+		const uint32 key = random.UInt32() % KeyRange;
+		if (random.UInt32() % 100 < worker->AddPercentage)
+		{
+			checksum += worker->SharedTable->GetOrAdd(key);
+		}
+		else
+		{
+			checksum += worker->SharedTable->Find(key);
+		}
+
+		if (i % CountInterval == 0)
+		{
+			checksum += worker->SharedTable->GetCount();
+		}
+	}
+	worker->Checksum = checksum;
+	return 0;
+}
+
+template<typename Table>
+static float64 MeasureTable(uint32 threadCount, uint32 addPercentage)
+{
+	Table table;
+	for (uint32 key = 0; key < KeyRange; key += 2)
+	{
+		table.GetOrAdd(key);
+	}
+
+	Atomic<uint32> readyCount;
+	Atomic<uint32> go;
+	Worker<Table> workers[MaxThreadCount];
+	HANDLE threads[MaxThreadCount];
+	for (uint32 i = 0; i < threadCount; ++i)
+	{
+		workers[i] = Worker<Table> { &table, &readyCount, &go, i + 1, addPercentage, 0 };
+		threads[i] = CreateThread(nullptr, 0, RunWorker<Table>, &workers[i], 0, nullptr);
+		CHECK(threads[i]);
+	}
+
+	while (readyCount.Load() != threadCount)
+	{
+	}
+
+	const float64 start = Platform::GetTime();
+	go.Store(1);
+	CHECK(WaitForMultipleObjects(threadCount, threads, TRUE, INFINITE) == WAIT_OBJECT_0);
+	const float64 end = Platform::GetTime();
+
+	for (uint32 i = 0; i < threadCount; ++i)
+	{
+		CHECK(CloseHandle(threads[i]));
+	}
+
+	return static_cast<float64>(threadCount * OperationsPerThread) / (end - start) / 1e6;
+}
+
+void RunConcurrentHashTableBenchmark()
+{
+	for (const uint32 addPercentage : { 0U, 10U })
+	{
+		printf("ConcurrentHashTable: %u%% GetOrAdd, the rest Find, GetCount every %llu operations, million operations per second\n", addPercentage, CountInterval);
+
+		for (uint32 threadCount = 1; threadCount <= MaxThreadCount; threadCount *= 2)
+		{
+			const float64 locked = MeasureTable<LockedHashTable>(threadCount, addPercentage);
+			const float64 sharded = MeasureTable<ShardedHashTable>(threadCount, addPercentage);
+			printf("%2u threads   Mutex + HashTable %8.2f   ConcurrentHashTable %8.2f\n", threadCount, locked, sharded);
+		}
+	}
+}
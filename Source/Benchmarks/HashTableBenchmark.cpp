@@ -0,0 +1,60 @@
+#include "Benchmarks.hpp"
+#include "BucketHashTable.hpp"
+
+#include "Luft/Base.hpp"
+#include "Luft/HashTable.hpp"
+#include "Luft/Platform.hpp"
+
+#include <stdio.h>
+
+static constexpr usize LookupRounds = 4;
+
+static uint32 GetKey(uint32 index)
+{
+	return index * 2654435761U;
+}
+
+template<typename Table>
+static void MeasureTable(const char* name, Table* table, uint32 keyCount)
+{
+	const float64 insertStart = Platform::GetTime();
+	for (uint32 i = 0; i < keyCount; ++i)
+	{
+		table->Add(GetKey(i), i);
+	}
+
+	const float64 lookupStart = Platform::GetTime();
+	uint64 checksum = 0;
+	for (usize round = 0; round < LookupRounds; ++round)
+	{
+		for (uint32 i = 0; i < keyCount * 2; ++i)
+		{
+			if (const uint32* value = table->Find(GetKey(i)))
+			{
+				checksum += *value;
+			}
+		}
+	}
+	const float64 lookupEnd = Platform::GetTime();
+
+	const float64 insertNanoseconds = (lookupStart - insertStart) * 1e9 / keyCount;
+	const float64 lookupNanoseconds = (lookupEnd - lookupStart) * 1e9 / (keyCount * 2.0 * LookupRounds);
+	printf("%-8s %9u keys   insert %7.2f ns   lookup %7.2f ns   checksum %llu\n", name, keyCount, insertNanoseconds, lookupNanoseconds, checksum);
+}
+
+void RunHashTableBenchmark()
+{
+	printf("HashTable: uint32 keys, half of the lookups miss\n");
+
+	for (const uint32 keyCount : { 1000U, 100000U, 1000000U })
+	{
+		{
+			BucketHashTable<uint32, uint32> table(keyCount);
+			MeasureTable("Bucket", &table, keyCount);
+		}
+		{
+			HashTable<uint32, uint32> table(keyCount);
+			MeasureTable("Flat", &table, keyCount);
+		}
+	}
+}
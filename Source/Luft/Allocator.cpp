@@ -1,20 +1,553 @@
 #include "Allocator.hpp"
+#include "Atomic.hpp"
 #include "PlatformCore.hpp"
 #include "Error.hpp"
+#include "Math.hpp"
+#include "Mutex.hpp"
+#include "SlabAllocator.hpp"
+#include "TlsfAllocator.hpp"
 
-void* GlobalAllocator::Allocate(usize size)
+bool Allocator::TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
 {
-	Used += size;
+	(void)ptr;
+	(void)oldSize;
+	(void)newSize;
+	(void)alignment;
+	return false;
+}
+
+void* Allocator::Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	if (ptr == nullptr)
+	{
+		return Allocate(newSize, alignment);
+	}
+	if (newSize >= oldSize && TryExpandInPlace(ptr, oldSize, newSize, alignment))
+	{
+		return ptr;
+	}
+
+	void* resized = Allocate(newSize, alignment);
+	Platform::MemoryCopy(resized, ptr, Min(oldSize, newSize));
+	Deallocate(ptr, oldSize, alignment);
+	return resized;
+}
+
+static constexpr usize UsedShardCount = 64;
+static constexpr usize CentralChunkSize = KB(64);
+
+struct alignas(64) UsedShard
+{
+	Atomic<int64> Used;
+};
+
+static UsedShard UsedShards[UsedShardCount];
+static Atomic<uint32> NextThreadIndex;
+
+struct FreeNode
+{
+	FreeNode* Next;
+};
+
+static usize GetBatchCount(usize sizeClass)
+{
+	return Clamp<usize>(KB(4) / SlabAllocator::GetSizeClassSize(sizeClass), 4, 64);
+}
+
+class CentralCache : public NoCopy
+{
+public:
+	constexpr CentralCache()
+		: FreeLists {}
+	{
+	}
+
+	FreeNode* TakeBatch(usize sizeClass, usize batchCount, usize* outCount)
+	{
+		MutexLock lock(&Lock);
+
+		if (FreeLists[sizeClass] == nullptr)
+		{
+			AllocateChunk(sizeClass);
+		}
+
+		FreeNode* head = FreeLists[sizeClass];
+		FreeNode* tail = head;
+		usize count = 1;
+		while (count < batchCount && tail->Next)
+		{
+			tail = tail->Next;
+			++count;
+		}
+		FreeLists[sizeClass] = tail->Next;
+		tail->Next = nullptr;
+
+		*outCount = count;
+		return head;
+	}
+
+	void ReturnBatch(usize sizeClass, FreeNode* head, FreeNode* tail)
+	{
+		MutexLock lock(&Lock);
+
+		tail->Next = FreeLists[sizeClass];
+		FreeLists[sizeClass] = head;
+	}
+
+private:
+	void AllocateChunk(usize sizeClass)
+	{
+		const usize objectSize = SlabAllocator::GetSizeClassSize(sizeClass);
+		const usize objectCount = CentralChunkSize / objectSize;
+		uint8* objects = static_cast<uint8*>(Platform::Allocate(CentralChunkSize));
+
+		FreeNode* head = FreeLists[sizeClass];
+		for (usize i = objectCount; i > 0; --i)
+		{
+			FreeNode* node = reinterpret_cast<FreeNode*>(objects + (i - 1) * objectSize);
+			node->Next = head;
+			head = node;
+		}
+		FreeLists[sizeClass] = head;
+	}
+
+	Mutex Lock;
+	FreeNode* FreeLists[SlabAllocator::SizeClassCount];
+};
+
+static CentralCache Central;
+
+// Thread locals of the main thread are destroyed before statics, which may still free through the cache.
+static thread_local bool IsLocalCacheDestroyed;
+
+class ThreadCache : public NoCopy
+{
+public:
+	constexpr ThreadCache()
+		: FreeLists {}
+		, FreeCounts {}
+		, ShardIndex(UsedShardCount)
+	{
+	}
+
+	~ThreadCache()
+	{
+		for (usize sizeClass = 0; sizeClass < SlabAllocator::SizeClassCount; ++sizeClass)
+		{
+			FreeNode* head = FreeLists[sizeClass];
+			if (head == nullptr)
+			{
+				continue;
+			}
+
+			FreeNode* tail = head;
+			while (tail->Next)
+			{
+				tail = tail->Next;
+			}
+			Central.ReturnBatch(sizeClass, head, tail);
+
+			FreeLists[sizeClass] = nullptr;
+			FreeCounts[sizeClass] = 0;
+		}
+		IsLocalCacheDestroyed = true;
+	}
+
+	void* Allocate(usize sizeClass)
+	{
+		if (FreeLists[sizeClass] == nullptr)
+		{
+			FreeLists[sizeClass] = Central.TakeBatch(sizeClass, GetBatchCount(sizeClass), &FreeCounts[sizeClass]);
+		}
+
+		FreeNode* node = FreeLists[sizeClass];
+		FreeLists[sizeClass] = node->Next;
+		--FreeCounts[sizeClass];
+		return node;
+	}
+
+	void Deallocate(void* ptr, usize sizeClass)
+	{
+		FreeNode* node = static_cast<FreeNode*>(ptr);
+		node->Next = FreeLists[sizeClass];
+		FreeLists[sizeClass] = node;
+		++FreeCounts[sizeClass];
+
+		const usize batchCount = GetBatchCount(sizeClass);
+		if (FreeCounts[sizeClass] >= batchCount * 2)
+		{
+			FreeNode* head = FreeLists[sizeClass];
+			FreeNode* tail = head;
+			for (usize i = 1; i < batchCount; ++i)
+			{
+				tail = tail->Next;
+			}
+			FreeLists[sizeClass] = tail->Next;
+			FreeCounts[sizeClass] -= batchCount;
+
+			Central.ReturnBatch(sizeClass, head, tail);
+		}
+	}
+
+	Atomic<int64>& GetUsed()
+	{
+		if (ShardIndex == UsedShardCount)
+		{
+			ShardIndex = NextThreadIndex.FetchAdd(1) % UsedShardCount;
+		}
+		return UsedShards[ShardIndex].Used;
+	}
+
+private:
+	FreeNode* FreeLists[SlabAllocator::SizeClassCount];
+	usize FreeCounts[SlabAllocator::SizeClassCount];
+	usize ShardIndex;
+};
+
+static thread_local ThreadCache LocalCache;
+
+static Atomic<int64>& GetLocalUsed()
+{
+	return IsLocalCacheDestroyed ? UsedShards[0].Used : LocalCache.GetUsed();
+}
+
+static void* AllocateSmall(usize sizeClass)
+{
+	if (IsLocalCacheDestroyed)
+	{
+		usize count = 0;
+		return Central.TakeBatch(sizeClass, 1, &count);
+	}
+	return LocalCache.Allocate(sizeClass);
+}
+
+static void DeallocateSmall(void* ptr, usize sizeClass)
+{
+	if (IsLocalCacheDestroyed)
+	{
+		FreeNode* node = static_cast<FreeNode*>(ptr);
+		Central.ReturnBatch(sizeClass, node, node);
+		return;
+	}
+	LocalCache.Deallocate(ptr, sizeClass);
+}
+
+#if GLOBAL_ALLOCATOR_TLSF
+struct TlsfBackend
+{
+	Mutex Lock;
+	TlsfAllocator Tlsf;
+};
+
+static TlsfBackend& GetTlsfBackend()
+{
+	// Never destroyed, blocks may still be freed while other statics are torn down.
+	alignas(TlsfBackend) static uint8 storage[sizeof(TlsfBackend)];
+	static TlsfBackend* backend = new (storage, LuftNewMarker {}) TlsfBackend();
+	return *backend;
+}
+
+TlsfAllocator::Statistics GetGlobalTlsfStatistics()
+{
+	TlsfBackend& backend = GetTlsfBackend();
+	MutexLock lock(&backend.Lock);
+	return backend.Tlsf.GetStatistics();
+}
+#endif
+
+static void* AllocateLarge(usize size, usize alignment)
+{
+#if GLOBAL_ALLOCATOR_TLSF
+	TlsfBackend& backend = GetTlsfBackend();
+	MutexLock lock(&backend.Lock);
+	return backend.Tlsf.Allocate(size, alignment);
+#else
+	if (alignment > Allocator::DefaultAlignment)
+	{
+		return Platform::AllocateAligned(size, alignment);
+	}
 	return Platform::Allocate(size);
+#endif
 }
 
-void GlobalAllocator::Deallocate(void* ptr, usize size)
+static void DeallocateLarge(void* ptr, usize size, usize alignment)
 {
-	if (ptr)
+#if GLOBAL_ALLOCATOR_TLSF
+	TlsfBackend& backend = GetTlsfBackend();
+	MutexLock lock(&backend.Lock);
+	backend.Tlsf.Deallocate(ptr, size, alignment);
+#else
+	(void)size;
+	if (alignment > Allocator::DefaultAlignment)
 	{
-		Used -= size;
+		Platform::DeallocateAligned(ptr);
+		return;
 	}
 	Platform::Deallocate(ptr);
+#endif
+}
+
+static bool TryExpandLargeInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+#if GLOBAL_ALLOCATOR_TLSF
+	TlsfBackend& backend = GetTlsfBackend();
+	MutexLock lock(&backend.Lock);
+	return backend.Tlsf.TryExpandInPlace(ptr, oldSize, newSize, alignment);
+#else
+	(void)oldSize;
+	if (alignment > Allocator::DefaultAlignment)
+	{
+		return false;
+	}
+	return Platform::TryReallocateInPlace(ptr, newSize);
+#endif
+}
+
+static bool IsLarge(usize size, usize alignment)
+{
+	return size > SlabAllocator::MaxSmallSize || alignment > Allocator::DefaultAlignment;
+}
+
+usize GlobalAllocator::GetUsed() const
+{
+	int64 used = 0;
+	for (const UsedShard& shard : UsedShards)
+	{
+		used += shard.Used.Load();
+	}
+	return static_cast<usize>(used);
+}
+
+void* GlobalAllocator::Allocate(usize size, usize alignment)
+{
+	CHECK(IsPowerOfTwo(alignment));
+
+	GetLocalUsed().FetchAdd(static_cast<int64>(size));
+
+	if (IsLarge(size, alignment))
+	{
+		return AllocateLarge(size, alignment);
+	}
+	return AllocateSmall(SlabAllocator::GetSizeClass(size));
+}
+
+void GlobalAllocator::Deallocate(void* ptr, usize size, usize alignment)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	GetLocalUsed().FetchSub(static_cast<int64>(size));
+
+	if (IsLarge(size, alignment))
+	{
+		DeallocateLarge(ptr, size, alignment);
+		return;
+	}
+	DeallocateSmall(ptr, SlabAllocator::GetSizeClass(size));
+}
+
+bool GlobalAllocator::TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	CHECK(ptr);
+	CHECK(newSize >= oldSize);
+
+	bool expanded = false;
+	if (IsLarge(oldSize, alignment))
+	{
+		expanded = TryExpandLargeInPlace(ptr, oldSize, newSize, alignment);
+	}
+	else if (newSize <= SlabAllocator::MaxSmallSize)
+	{
+		expanded = SlabAllocator::GetSizeClass(newSize) == SlabAllocator::GetSizeClass(oldSize);
+	}
+
+	if (expanded)
+	{
+		GetLocalUsed().FetchAdd(static_cast<int64>(newSize - oldSize));
+	}
+	return expanded;
+}
+
+void* GlobalAllocator::Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+#if GLOBAL_ALLOCATOR_TLSF
+	return Allocator::Reallocate(ptr, oldSize, newSize, alignment);
+#else
+	const bool isLarge = oldSize > SlabAllocator::MaxSmallSize && newSize > SlabAllocator::MaxSmallSize;
+	if (ptr == nullptr || !isLarge || alignment > DefaultAlignment)
+	{
+		return Allocator::Reallocate(ptr, oldSize, newSize, alignment);
+	}
+
+	GetLocalUsed().FetchAdd(static_cast<int64>(newSize) - static_cast<int64>(oldSize));
+	return Platform::Reallocate(ptr, newSize);
+#endif
+}
+
+ArenaAllocator::ArenaAllocator(usize blockSize, Allocator* parent)
+	: First(nullptr)
+	, Current(nullptr)
+	, Offset(0)
+	, BlockSize(blockSize)
+	, Parent(parent)
+{
+	CHECK(BlockSize > 0);
+	CHECK(Parent);
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+	Block* block = First;
+	while (block)
+	{
+		Block* next = block->Next;
+		Parent->Deallocate(block, sizeof(Block) + block->Size);
+		block = next;
+	}
+
+	First = nullptr;
+	Current = nullptr;
+	Offset = 0;
+}
+
+void* ArenaAllocator::Allocate(usize size, usize alignment)
+{
+	alignment = Max(alignment, DefaultAlignment);
+	const usize alignedSize = size + alignment - DefaultAlignment;
+
+	usize alignedOffset = Current ? GetAlignedOffset(Current, Offset, alignment) : 0;
+	while (Current == nullptr || alignedOffset + size > Current->Size)
+	{
+		Block* next = Current ? Current->Next : First;
+		if (next == nullptr || alignedSize > next->Size)
+		{
+			const usize newBlockSize = AlignUp(Max(alignedSize, BlockSize), DefaultAlignment);
+			Block* newBlock = static_cast<Block*>(Parent->Allocate(sizeof(Block) + newBlockSize));
+			newBlock->Next = next;
+			newBlock->Size = newBlockSize;
+
+			if (Current)
+			{
+				Current->Next = newBlock;
+			}
+			else
+			{
+				First = newBlock;
+			}
+			next = newBlock;
+		}
+
+		Current = next;
+		alignedOffset = GetAlignedOffset(Current, 0, alignment);
+	}
+
+	void* ptr = GetBlockData(Current) + alignedOffset;
+	Offset = alignedOffset + size;
+	return ptr;
+}
+
+void ArenaAllocator::Deallocate(void* ptr, usize size, usize alignment)
+{
+	(void)alignment;
+
+	if (ptr == nullptr || Current == nullptr)
+	{
+		return;
+	}
+
+	uint8* data = GetBlockData(Current);
+	uint8* bytes = static_cast<uint8*>(ptr);
+	if (bytes >= data && bytes + size == data + Offset)
+	{
+		Offset = static_cast<usize>(bytes - data);
+	}
+}
+
+bool ArenaAllocator::TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	(void)alignment;
+
+	CHECK(ptr);
+	CHECK(newSize >= oldSize);
+
+	if (Current == nullptr)
+	{
+		return false;
+	}
+
+	uint8* data = GetBlockData(Current);
+	uint8* bytes = static_cast<uint8*>(ptr);
+	if (bytes < data || bytes + oldSize != data + Offset)
+	{
+		return false;
+	}
+
+	const usize offset = static_cast<usize>(bytes - data);
+	if (offset + newSize > Current->Size)
+	{
+		return false;
+	}
+
+	Offset = offset + newSize;
+	return true;
+}
+
+usize ArenaAllocator::GetAlignedOffset(Block* block, usize offset, usize alignment)
+{
+	const uint64 address = reinterpret_cast<uint64>(GetBlockData(block)) + offset;
+	return offset + (AlignUp(address, alignment) - address);
+}
+
+void ArenaAllocator::RollbackToMarker(Marker marker)
+{
+#if DEBUG
+	bool found = marker.Block == nullptr;
+	for (Block* block = First; block && !found; block = block->Next)
+	{
+		found = block == marker.Block;
+		if (block == Current)
+		{
+			break;
+		}
+	}
+	CHECK(found);
+#endif
+
+	Current = static_cast<Block*>(marker.Block);
+	Offset = marker.Offset;
+}
+
+class PlatformAllocator final : public Allocator
+{
+public:
+	void* Allocate(usize size, usize alignment = DefaultAlignment) override
+	{
+		CHECK(alignment <= DefaultAlignment);
+		return Platform::Allocate(size);
+	}
+
+	void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) override
+	{
+		(void)size;
+		(void)alignment;
+		Platform::Deallocate(ptr);
+	}
+};
+
+static constexpr usize ScratchBlockSize = KB(64);
+
+static PlatformAllocator ScratchParent;
+static thread_local ArenaAllocator ScratchArenas[2] =
+{
+	ArenaAllocator(ScratchBlockSize, &ScratchParent),
+	ArenaAllocator(ScratchBlockSize, &ScratchParent),
+};
+
+ArenaAllocator* GetScratch(const Allocator* conflict)
+{
+	return &ScratchArenas[0] == conflict ? &ScratchArenas[1] : &ScratchArenas[0];
 }
 
 #if DEBUG
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "Base.hpp"
+#include "Error.hpp"
 #include "Meta.hpp"
 #include "NoCopy.hpp"
 
+#ifndef GLOBAL_ALLOCATOR_TLSF
+#define GLOBAL_ALLOCATOR_TLSF 0
+#endif
+
 struct LuftNewMarker {};
 
 inline void* operator new(usize size, void* at, LuftNewMarker) noexcept
@@ -15,15 +20,20 @@ inline void* operator new(usize size, void* at, LuftNewMarker) noexcept
 class Allocator : public NoCopy
 {
 public:
+	static constexpr usize DefaultAlignment = 16;
+
 	virtual ~Allocator() = default;
 
-	virtual void* Allocate(usize size) = 0;
-	virtual void Deallocate(void* ptr, usize size) = 0;
+	virtual void* Allocate(usize size, usize alignment = DefaultAlignment) = 0;
+	virtual void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) = 0;
+
+	virtual bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment);
+	virtual void* Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment);
 
 	template<typename T, typename... Args>
 	T* Create(Args&&... args)
 	{
-		T* object = static_cast<T*>(Allocate(sizeof(T)));
+		T* object = static_cast<T*>(Allocate(sizeof(T), alignof(T)));
 		object = new (object, LuftNewMarker {}) T(Forward<Args>(args)...);
 		return object;
 	}
@@ -35,7 +45,7 @@ public:
 		{
 			object->~T();
 		}
-		Deallocate(object, sizeof(T));
+		Deallocate(object, sizeof(T), alignof(T));
 	}
 };
 
@@ -44,20 +54,222 @@ class GlobalAllocator final : public Allocator
 public:
 	static GlobalAllocator& Get()
 	{
-		static GlobalAllocator instance;
-		return instance;
+		return Instance;
 	}
 
-	usize GetUsed() const
+	usize GetUsed() const;
+
+	void* Allocate(usize size, usize alignment = DefaultAlignment) override;
+	void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) override;
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+	void* Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+
+private:
+	constexpr GlobalAllocator() = default;
+
+	static GlobalAllocator Instance;
+};
+
+inline constinit GlobalAllocator GlobalAllocator::Instance;
+
+class DynamicAllocatorPolicy
+{
+public:
+	DynamicAllocatorPolicy()
+		: Allocator(GetDefaultAllocator())
 	{
-		return Used;
 	}
 
-	void* Allocate(usize size) override;
-	void Deallocate(void* ptr, usize size) override;
+	explicit DynamicAllocatorPolicy(Allocator* allocator)
+		: Allocator(allocator)
+	{
+	}
+
+	~DynamicAllocatorPolicy()
+	{
+		Allocator = nullptr;
+	}
+
+	DynamicAllocatorPolicy(const DynamicAllocatorPolicy& copy) = default;
+	DynamicAllocatorPolicy& operator=(const DynamicAllocatorPolicy& copy) = default;
+
+	DynamicAllocatorPolicy(DynamicAllocatorPolicy&& move) noexcept
+		: Allocator(move.Allocator)
+	{
+		move.Allocator = nullptr;
+	}
+
+	DynamicAllocatorPolicy& operator=(DynamicAllocatorPolicy&& move) noexcept
+	{
+		Allocator = move.Allocator;
+		move.Allocator = nullptr;
+		return *this;
+	}
+
+	static Allocator* GetDefaultAllocator()
+	{
+		return &GlobalAllocator::Get();
+	}
+
+	Allocator* GetAllocator() const
+	{
+		return Allocator;
+	}
+
+	bool HasAllocator() const
+	{
+		return Allocator != nullptr;
+	}
+
+	void* Allocate(usize size, usize alignment = Allocator::DefaultAlignment)
+	{
+		return Allocator->Allocate(size, alignment);
+	}
+
+	void Deallocate(void* ptr, usize size, usize alignment = Allocator::DefaultAlignment)
+	{
+		Allocator->Deallocate(ptr, size, alignment);
+	}
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = Allocator::DefaultAlignment)
+	{
+		return Allocator->TryExpandInPlace(ptr, oldSize, newSize, alignment);
+	}
+
+	void* Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment = Allocator::DefaultAlignment)
+	{
+		return Allocator->Reallocate(ptr, oldSize, newSize, alignment);
+	}
 
 private:
-	GlobalAllocator() = default;
+	Allocator* Allocator;
+};
+
+template<typename A>
+class StaticAllocatorPolicy
+{
+public:
+	StaticAllocatorPolicy() = default;
 
-	usize Used = 0;
+	explicit StaticAllocatorPolicy(Allocator* allocator)
+	{
+		CHECK(allocator == &A::Get());
+	}
+
+	static Allocator* GetDefaultAllocator()
+	{
+		return &A::Get();
+	}
+
+	Allocator* GetAllocator() const
+	{
+		return &A::Get();
+	}
+
+	bool HasAllocator() const
+	{
+		return true;
+	}
+
+	void* Allocate(usize size, usize alignment = Allocator::DefaultAlignment)
+	{
+		return A::Get().A::Allocate(size, alignment);
+	}
+
+	void Deallocate(void* ptr, usize size, usize alignment = Allocator::DefaultAlignment)
+	{
+		A::Get().A::Deallocate(ptr, size, alignment);
+	}
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = Allocator::DefaultAlignment)
+	{
+		return A::Get().A::TryExpandInPlace(ptr, oldSize, newSize, alignment);
+	}
+
+	void* Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment = Allocator::DefaultAlignment)
+	{
+		return A::Get().A::Reallocate(ptr, oldSize, newSize, alignment);
+	}
+};
+
+using GlobalAllocatorPolicy = StaticAllocatorPolicy<GlobalAllocator>;
+
+class ArenaAllocator final : public Allocator
+{
+public:
+	struct Marker
+	{
+		void* Block;
+		usize Offset;
+	};
+
+	explicit ArenaAllocator(usize blockSize = MB(1), Allocator* parent = &GlobalAllocator::Get());
+	~ArenaAllocator() override;
+
+	void* Allocate(usize size, usize alignment = DefaultAlignment) override;
+	void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) override;
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+
+	Marker GetMarker() const
+	{
+		return Marker { Current, Offset };
+	}
+
+	void RollbackToMarker(Marker marker);
+
+	void Reset()
+	{
+		Current = First;
+		Offset = 0;
+	}
+
+private:
+	struct Block
+	{
+		Block* Next;
+		usize Size;
+	};
+	static_assert(sizeof(Block) % DefaultAlignment == 0);
+
+	static uint8* GetBlockData(Block* block)
+	{
+		return reinterpret_cast<uint8*>(block) + sizeof(Block);
+	}
+
+	static usize GetAlignedOffset(Block* block, usize offset, usize alignment);
+
+	Block* First;
+	Block* Current;
+	usize Offset;
+
+	usize BlockSize;
+	Allocator* Parent;
+};
+
+ArenaAllocator* GetScratch(const Allocator* conflict = nullptr);
+
+class ScratchScope : public NoCopy
+{
+public:
+	explicit ScratchScope(const Allocator* conflict = nullptr)
+		: Scratch(GetScratch(conflict))
+		, Marker(Scratch->GetMarker())
+	{
+	}
+
+	~ScratchScope()
+	{
+		Scratch->RollbackToMarker(Marker);
+	}
+
+	ArenaAllocator* Get() const
+	{
+		return Scratch;
+	}
+
+private:
+	ArenaAllocator* Scratch;
+	ArenaAllocator::Marker Marker;
 };
@@ -3,6 +3,7 @@
 #include "Allocator.hpp"
 #include "Base.hpp"
 #include "Error.hpp"
+#include "Math.hpp"
 #include "Meta.hpp"
 
 #include <initializer_list>
@@ -82,7 +83,7 @@ public:
 		return Elements[Count - 1];
 	}
 
-	T* GetData() const
+	const T* GetData() const
 	{
 		return Elements;
 	}
@@ -122,35 +123,37 @@ private:
 	usize Count;
 };
 
-template<typename T>
-class Array
+template<typename T, typename AllocatorPolicy = DynamicAllocatorPolicy>
+class Array : private AllocatorPolicy
 {
 public:
+	using AllocatorPolicy::GetAllocator;
+
 	Array()
-		: Elements(nullptr)
+		: AllocatorPolicy()
+		, Elements(nullptr)
 		, Count(0)
 		, Capacity(0)
-		, Allocator(&GlobalAllocator::Get())
 	{
 	}
 
 	explicit Array(Allocator* allocator)
-		: Elements(nullptr)
+		: AllocatorPolicy(allocator)
+		, Elements(nullptr)
 		, Count(0)
 		, Capacity(0)
-		, Allocator(allocator)
 	{
 	}
 
-	explicit Array(usize capacity, Allocator* allocator = &GlobalAllocator::Get())
-		: Elements(nullptr)
+	explicit Array(usize capacity, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: AllocatorPolicy(allocator)
+		, Elements(nullptr)
 		, Count(0)
 		, Capacity(capacity)
-		, Allocator(allocator)
 	{
 		if (Capacity)
 		{
-			Elements = static_cast<T*>(Allocator->Allocate(Capacity * sizeof(T)));
+			Elements = static_cast<T*>(AllocatorPolicy::Allocate(Capacity * sizeof(T), alignof(T)));
 		}
 	}
 
@@ -165,7 +168,7 @@ public:
 
 	~Array()
 	{
-		if (Allocator)
+		if (AllocatorPolicy::HasAllocator())
 		{
 			if constexpr (!IsTriviallyDestructible<T>::Value)
 			{
@@ -174,7 +177,7 @@ public:
 					Elements[i].~T();
 				}
 			}
-			Allocator->Deallocate(Elements, Capacity * sizeof(T));
+			AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
 		}
 		else
 		{
@@ -184,16 +187,15 @@ public:
 		Elements = nullptr;
 		Count = 0;
 		Capacity = 0;
-		Allocator = nullptr;
 	}
 
 	Array(const Array& copy)
-		: Elements(nullptr)
+		: AllocatorPolicy(copy)
+		, Elements(nullptr)
 		, Count(copy.Count)
 		, Capacity(copy.Capacity)
-		, Allocator(copy.Allocator)
 	{
-		T* newElements = static_cast<T*>(Allocator->Allocate(Capacity * sizeof(T)));
+		T* newElements = static_cast<T*>(AllocatorPolicy::Allocate(Capacity * sizeof(T), alignof(T)));
 		if constexpr (IsTriviallyCopyable<T>::Value)
 		{
 			Platform::MemoryCopy(newElements, copy.Elements, Count * sizeof(T));
@@ -219,9 +221,9 @@ public:
 
 		Count = copy.Count;
 		Capacity = copy.Capacity;
-		Allocator = copy.Allocator;
+		AllocatorPolicy::operator=(copy);
 
-		T* newElements = static_cast<T*>(Allocator->Allocate(Capacity * sizeof(T)));
+		T* newElements = static_cast<T*>(AllocatorPolicy::Allocate(Capacity * sizeof(T), alignof(T)));
 		if constexpr (IsTriviallyCopyable<T>::Value)
 		{
 			Platform::MemoryCopy(newElements, copy.Elements, Count * sizeof(T));
@@ -239,15 +241,14 @@ public:
 	}
 
 	Array(Array&& move) noexcept
-		: Elements(move.Elements)
+		: AllocatorPolicy(Move(move))
+		, Elements(move.Elements)
 		, Count(move.Count)
 		, Capacity(move.Capacity)
-		, Allocator(move.Allocator)
 	{
 		move.Elements = nullptr;
 		move.Count = 0;
 		move.Capacity = 0;
-		move.Allocator = nullptr;
 	}
 
 	Array& operator=(Array&& move) noexcept
@@ -262,12 +263,11 @@ public:
 		Elements = move.Elements;
 		Count = move.Count;
 		Capacity = move.Capacity;
-		Allocator = move.Allocator;
+		AllocatorPolicy::operator=(Move(move));
 
 		move.Elements = nullptr;
 		move.Count = 0;
 		move.Capacity = 0;
-		move.Allocator = nullptr;
 
 		return *this;
 	}
@@ -358,9 +358,15 @@ public:
 	{
 		if (Count == Capacity)
 		{
+			// The arguments may refer to elements, which growing frees.
+			T newElement(Forward<Args>(args)...);
 			Grow(Capacity ? Capacity * 2 : 8);
+			new (&Elements[Count], LuftNewMarker {}) T(Move(newElement));
+		}
+		else
+		{
+			new (&Elements[Count], LuftNewMarker {}) T(Forward<Args>(args)...);
 		}
-		new (&Elements[Count], LuftNewMarker {}) T(Forward<Args>(args)...);
 		++Count;
 	}
 
@@ -373,30 +379,580 @@ public:
 		Count += newCount;
 	}
 
+	void AddRange(ArrayView<T> range)
+	{
+		InsertRange(Count, range);
+	}
+
+	void Insert(usize index, const T& newElement)
+	{
+		EmplaceAt(index, newElement);
+	}
+
+	void Insert(usize index, T&& newElement)
+	{
+		EmplaceAt(index, Move(newElement));
+	}
+
+	template<typename... Args>
+	void EmplaceAt(usize index, Args&&... args)
+	{
+		CHECK(index <= Count);
+
+		T newElement(Forward<Args>(args)...);
+		EnsureCapacity(Count + 1);
+		Relocate(Elements + index + 1, Elements + index, Count - index);
+		new (&Elements[index], LuftNewMarker {}) T(Move(newElement));
+		++Count;
+	}
+
+	void InsertRange(usize index, ArrayView<T> range)
+	{
+		CHECK(index <= Count);
+
+		const usize rangeCount = range.GetCount();
+		if (rangeCount == 0)
+		{
+			return;
+		}
+
+		// A range taken from this array is tracked by position, since growing may move it and the insertion shifts its tail.
+		const T* source = range.GetData();
+		const bool isAliased = source >= Elements && source < Elements + Count;
+		const usize sourceIndex = isAliased ? static_cast<usize>(source - Elements) : 0;
+
+		EnsureCapacity(Count + rangeCount);
+		Relocate(Elements + index + rangeCount, Elements + index, Count - index);
+		if (isAliased)
+		{
+			const usize headCount = sourceIndex < index ? Min(index - sourceIndex, rangeCount) : 0;
+			CopyConstruct(Elements + index, Elements + sourceIndex, headCount);
+			CopyConstruct(Elements + index + headCount, Elements + sourceIndex + headCount + rangeCount, rangeCount - headCount);
+		}
+		else
+		{
+			CopyConstruct(Elements + index, source, rangeCount);
+		}
+		Count += rangeCount;
+	}
+
+	void Resize(usize newCount)
+	{
+		if (newCount < Count)
+		{
+			RemoveRange(newCount, Count - newCount);
+			return;
+		}
+
+		EnsureCapacity(newCount);
+		for (usize i = Count; i < newCount; ++i)
+		{
+			new (&Elements[i], LuftNewMarker {}) T();
+		}
+		Count = newCount;
+	}
+
+	void Resize(usize newCount, const T& fill)
+	{
+		if (newCount < Count)
+		{
+			RemoveRange(newCount, Count - newCount);
+			return;
+		}
+
+		const bool isAliased = &fill >= Elements && &fill < Elements + Count;
+		const usize fillIndex = isAliased ? static_cast<usize>(&fill - Elements) : 0;
+
+		EnsureCapacity(newCount);
+		const T& source = isAliased ? Elements[fillIndex] : fill;
+		for (usize i = Count; i < newCount; ++i)
+		{
+			new (&Elements[i], LuftNewMarker {}) T(source);
+		}
+		Count = newCount;
+	}
+
 	void Reserve(usize totalCapacity)
 	{
-		CHECK(Elements == nullptr);
-		Capacity = totalCapacity;
-		Elements = static_cast<T*>(Allocator->Allocate(Capacity * sizeof(T)));
+		if (totalCapacity > Capacity)
+		{
+			Grow(totalCapacity);
+		}
+	}
+
+	void ShrinkToFit()
+	{
+		if (Capacity == Count)
+		{
+			return;
+		}
+
+		if (Count == 0)
+		{
+			AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
+			Elements = nullptr;
+		}
+		else if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			Elements = static_cast<T*>(AllocatorPolicy::Reallocate(Elements, Capacity * sizeof(T), Count * sizeof(T), alignof(T)));
+		}
+		else
+		{
+			T* resized = static_cast<T*>(AllocatorPolicy::Allocate(Count * sizeof(T), alignof(T)));
+			Relocate(resized, Elements, Count);
+			AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
+			Elements = resized;
+		}
+
+		Capacity = Count;
 	}
 
 	void Remove(usize index)
+	{
+		RemoveRange(index, 1);
+	}
+
+	void RemoveRange(usize index, usize removeCount)
+	{
+		CHECK(index <= Count && removeCount <= Count - index);
+
+		if constexpr (!IsTriviallyDestructible<T>::Value)
+		{
+			for (usize i = index; i < index + removeCount; ++i)
+			{
+				Elements[i].~T();
+			}
+		}
+		Relocate(Elements + index, Elements + index + removeCount, Count - index - removeCount);
+
+		Count -= removeCount;
+	}
+
+	void RemoveSwap(usize index)
 	{
 		CHECK(index < Count);
 
+		Elements[index].~T();
+		if (index != Count - 1)
+		{
+			Relocate(Elements + index, Elements + Count - 1, 1);
+		}
+
+		--Count;
+	}
+
+	template<typename Predicate>
+	usize RemoveIf(const Predicate& predicate)
+	{
+		usize keptCount = 0;
+		for (usize i = 0; i < Count; ++i)
+		{
+			if (predicate(AsConst(Elements[i])))
+			{
+				Elements[i].~T();
+			}
+			else
+			{
+				if (keptCount != i)
+				{
+					Relocate(Elements + keptCount, Elements + i, 1);
+				}
+				++keptCount;
+			}
+		}
+
+		const usize removedCount = Count - keptCount;
+		Count = keptCount;
+		return removedCount;
+	}
+
+	void Clear()
+	{
+		if constexpr (!IsTriviallyCopyable<T>::Value)
+		{
+			for (usize i = 0; i < Count; ++i)
+			{
+				Elements[i].~T();
+			}
+		}
+		Count = 0;
+	}
+
+	T* Surrender()
+	{
+		T* data = Elements;
+		Elements = nullptr;
+		Count = 0;
+		Capacity = 0;
+		return data;
+	}
+
+	ArrayIterator<T> begin()
+	{
+		return ArrayIterator<T>(Elements);
+	}
+
+	ArrayIterator<T> end()
+	{
+		return ArrayIterator<T>(Elements + Count);
+	}
+
+	ArrayIterator<const T> begin() const
+	{
+		return ArrayIterator<const T>(Elements);
+	}
+
+	ArrayIterator<const T> end() const
+	{
+		return ArrayIterator<const T>(Elements + Count);
+	}
+
+private:
+	// Moves elements between possibly overlapping ranges. The destination must be uninitialized,
+	// the source is left uninitialized.
+	static void Relocate(T* destination, T* source, usize relocateCount)
+	{
+		if (relocateCount == 0 || destination == source)
+		{
+			return;
+		}
+
+		if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			Platform::MemoryMove(destination, source, relocateCount * sizeof(T));
+		}
+		else if (destination < source)
+		{
+			for (usize i = 0; i < relocateCount; ++i)
+			{
+				new (&destination[i], LuftNewMarker {}) T(MoveIfPossible(source[i]));
+				source[i].~T();
+			}
+		}
+		else
+		{
+			for (usize i = relocateCount; i > 0; --i)
+			{
+				new (&destination[i - 1], LuftNewMarker {}) T(MoveIfPossible(source[i - 1]));
+				source[i - 1].~T();
+			}
+		}
+	}
+
+	static void CopyConstruct(T* destination, const T* source, usize copyCount)
+	{
 		if constexpr (IsTriviallyCopyable<T>::Value)
 		{
+			if (copyCount > 0)
+			{
+				Platform::MemoryCopy(destination, source, copyCount * sizeof(T));
+			}
+		}
+		else
+		{
+			for (usize i = 0; i < copyCount; ++i)
+			{
+				new (&destination[i], LuftNewMarker {}) T(source[i]);
+			}
+		}
+	}
+
+	void EnsureCapacity(usize totalCapacity)
+	{
+		if (totalCapacity > Capacity)
+		{
+			const usize doubledCapacity = Capacity ? Capacity * 2 : 8;
+			Grow(totalCapacity > doubledCapacity ? totalCapacity : doubledCapacity);
+		}
+	}
+
+	void Grow(usize totalCapacity)
+	{
+		CHECK(totalCapacity >= Capacity);
+
+		const usize totalSize = totalCapacity * sizeof(T);
+
+		if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			Elements = static_cast<T*>(AllocatorPolicy::Reallocate(Elements, Capacity * sizeof(T), totalSize, alignof(T)));
+		}
+		else if (Elements == nullptr || !AllocatorPolicy::TryExpandInPlace(Elements, Capacity * sizeof(T), totalSize, alignof(T)))
+		{
+			T* resized = static_cast<T*>(AllocatorPolicy::Allocate(totalSize, alignof(T)));
+			for (usize i = 0; i < Count; ++i)
+			{
+				new (&resized[i], LuftNewMarker {}) T(MoveIfPossible(Elements[i]));
+			}
+			for (usize i = 0; i < Count; ++i)
+			{
+				Elements[i].~T();
+			}
+			AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
+
+			Elements = resized;
+		}
+
+		Capacity = totalCapacity;
+	}
+
+	T* Elements;
+	usize Count;
+	usize Capacity;
+};
+
+template<typename T, typename AllocatorPolicy>
+struct IsTriviallyRelocatable<Array<T, AllocatorPolicy>> : TrueConstant {};
+
+template<typename T, usize N, typename AllocatorPolicy = DynamicAllocatorPolicy>
+class InlineArray : private AllocatorPolicy
+{
+public:
+	static_assert(N > 0);
+
+	using AllocatorPolicy::GetAllocator;
+
+	InlineArray()
+		: AllocatorPolicy()
+		, Elements(GetInlineElements())
+		, Count(0)
+		, Capacity(N)
+	{
+	}
+
+	explicit InlineArray(Allocator* allocator)
+		: AllocatorPolicy(allocator)
+		, Elements(GetInlineElements())
+		, Count(0)
+		, Capacity(N)
+	{
+	}
+
+	explicit InlineArray(usize capacity, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: AllocatorPolicy(allocator)
+		, Elements(GetInlineElements())
+		, Count(0)
+		, Capacity(N)
+	{
+		Reserve(capacity);
+	}
+
+	InlineArray(std::initializer_list<T> elements)
+		: InlineArray()
+	{
+		Reserve(elements.size());
+		for (const T& element : elements)
+		{
+			Add(element);
+		}
+	}
+
+	~InlineArray()
+	{
+		Clear();
+		if (!IsInline())
+		{
+			AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
+		}
+
+		Elements = nullptr;
+		Capacity = 0;
+	}
+
+	InlineArray(const InlineArray& copy)
+		: AllocatorPolicy(copy)
+		, Elements(GetInlineElements())
+		, Count(0)
+		, Capacity(N)
+	{
+		CopyFrom(copy);
+	}
+
+	InlineArray& operator=(const InlineArray& copy)
+	{
+		if (&copy == this)
+		{
+			return *this;
+		}
+
+		this->~InlineArray();
+
+		AllocatorPolicy::operator=(copy);
+		Elements = GetInlineElements();
+		Capacity = N;
+		CopyFrom(copy);
+
+		return *this;
+	}
+
+	// The allocator is copied rather than moved, so a moved-from array stays usable.
+	InlineArray(InlineArray&& move) noexcept
+		: AllocatorPolicy(static_cast<const AllocatorPolicy&>(move))
+		, Elements(GetInlineElements())
+		, Count(0)
+		, Capacity(N)
+	{
+		MoveFrom(move);
+	}
+
+	InlineArray& operator=(InlineArray&& move) noexcept
+	{
+		if (&move == this)
+		{
+			return *this;
+		}
+
+		this->~InlineArray();
+
+		AllocatorPolicy::operator=(static_cast<const AllocatorPolicy&>(move));
+		Elements = GetInlineElements();
+		Capacity = N;
+		MoveFrom(move);
+
+		return *this;
+	}
+
+	T& operator[](usize index)
+	{
+		CHECK(index < Count);
+		return Elements[index];
+	}
+
+	const T& operator[](usize index) const
+	{
+		CHECK(index < Count);
+		return Elements[index];
+	}
+
+	operator ArrayView<T>() const
+	{
+		return ArrayView<T>(Elements, Count);
+	}
+
+	static InlineArray Empty()
+	{
+		return InlineArray();
+	}
+
+	T& First()
+	{
+		CHECK(!IsEmpty());
+		return Elements[0];
+	}
+
+	const T& First() const
+	{
+		CHECK(!IsEmpty());
+		return Elements[0];
+	}
+
+	T& Last()
+	{
+		CHECK(!IsEmpty());
+		return Elements[Count - 1];
+	}
+
+	const T& Last() const
+	{
+		CHECK(!IsEmpty());
+		return Elements[Count - 1];
+	}
+
+	T* GetData() const
+	{
+		return Elements;
+	}
+
+	usize GetCount() const
+	{
+		return Count;
+	}
+
+	usize GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	usize GetElementSize() const
+	{
+		return sizeof(T);
+	}
+
+	usize GetDataSize() const
+	{
+		return Count * GetElementSize();
+	}
+
+	bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	bool IsInline() const
+	{
+		return Elements == GetInlineElements();
+	}
+
+	void Add(const T& newElement)
+	{
+		Emplace(newElement);
+	}
+
+	void Add(T&& newElement)
+	{
+		Emplace(Move(newElement));
+	}
+
+	template<typename... Args>
+	void Emplace(Args&&... args)
+	{
+		if (Count == Capacity)
+		{
+			// The arguments may refer to elements, which growing relocates.
+			T newElement(Forward<Args>(args)...);
+			Grow(Capacity * 2);
+			new (&Elements[Count], LuftNewMarker {}) T(Move(newElement));
+		}
+		else
+		{
+			new (&Elements[Count], LuftNewMarker {}) T(Forward<Args>(args)...);
+		}
+		++Count;
+	}
+
+	void AddUninitialized(usize newCount)
+	{
+		if (Count + newCount > Capacity)
+		{
+			Grow(Count + newCount);
+		}
+		Count += newCount;
+	}
+
+	void Reserve(usize totalCapacity)
+	{
+		if (totalCapacity > Capacity)
+		{
+			Grow(totalCapacity);
+		}
+	}
+
+	void Remove(usize index)
+	{
+		CHECK(index < Count);
+
+		if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			Elements[index].~T();
 			const usize moveCount = Count - index - 1;
 			Platform::MemoryMove(Elements + index, Elements + index + 1, moveCount * sizeof(T));
 		}
 		else
 		{
-			Elements[index].~T();
 			for (usize i = index; i < Count - 1; ++i)
 			{
 				Elements[i] = MoveIfPossible(Elements[i + 1]);
-				Elements[i + 1].~T();
 			}
+			Elements[Count - 1].~T();
 		}
 
 		--Count;
@@ -404,7 +960,7 @@ public:
 
 	void Clear()
 	{
-		if constexpr (!IsTriviallyCopyable<T>::Value)
+		if constexpr (!IsTriviallyDestructible<T>::Value)
 		{
 			for (usize i = 0; i < Count; ++i)
 			{
@@ -416,10 +972,19 @@ public:
 
 	T* Surrender()
 	{
+		if (IsInline())
+		{
+			if (Count == 0)
+			{
+				return nullptr;
+			}
+			Grow(Capacity);
+		}
+
 		T* data = Elements;
-		Elements = nullptr;
+		Elements = GetInlineElements();
 		Count = 0;
-		Capacity = 0;
+		Capacity = N;
 		return data;
 	}
 
@@ -444,36 +1009,108 @@ public:
 	}
 
 private:
-	void Grow(usize totalCapacity)
+	T* GetInlineElements() const
 	{
-		CHECK(totalCapacity >= Capacity);
+		return reinterpret_cast<T*>(const_cast<uint8*>(InlineStorage));
+	}
 
-		const usize totalSize = totalCapacity * sizeof(T);
+	void CopyFrom(const InlineArray& copy)
+	{
+		CHECK(Count == 0);
 
-		T* resized = static_cast<T*>(Allocator->Allocate(totalSize));
+		Reserve(copy.Count);
 		if constexpr (IsTriviallyCopyable<T>::Value)
 		{
-			Platform::MemoryCopy(resized, Elements, Count * sizeof(T));
+			Platform::MemoryCopy(Elements, copy.Elements, copy.Count * sizeof(T));
 		}
 		else
 		{
-			for (usize i = 0; i < Count; ++i)
+			for (usize i = 0; i < copy.Count; ++i)
 			{
-				new (&resized[i], LuftNewMarker {}) T(MoveIfPossible(Elements[i]));
+				new (&Elements[i], LuftNewMarker {}) T(copy.Elements[i]);
 			}
+		}
+		Count = copy.Count;
+	}
+
+	void MoveFrom(InlineArray& move)
+	{
+		CHECK(Count == 0 && IsInline());
+
+		if (move.IsInline())
+		{
+			if constexpr (IsTriviallyRelocatable<T>::Value)
+			{
+				Platform::MemoryCopy(Elements, move.Elements, move.Count * sizeof(T));
+			}
+			else
+			{
+				for (usize i = 0; i < move.Count; ++i)
+				{
+					new (&Elements[i], LuftNewMarker {}) T(MoveIfPossible(move.Elements[i]));
+					move.Elements[i].~T();
+				}
+			}
+			Count = move.Count;
+			move.Count = 0;
+		}
+		else
+		{
+			Elements = move.Elements;
+			Count = move.Count;
+			Capacity = move.Capacity;
+
+			move.Elements = move.GetInlineElements();
+			move.Count = 0;
+			move.Capacity = N;
+		}
+	}
+
+	void Grow(usize totalCapacity)
+	{
+		CHECK(totalCapacity >= Capacity);
+
+		const usize totalSize = totalCapacity * sizeof(T);
+
+		if (IsInline())
+		{
+			T* resized = static_cast<T*>(AllocatorPolicy::Allocate(totalSize, alignof(T)));
+			if constexpr (IsTriviallyRelocatable<T>::Value)
+			{
+				Platform::MemoryCopy(resized, Elements, Count * sizeof(T));
+			}
+			else
+			{
+				for (usize i = 0; i < Count; ++i)
+				{
+					new (&resized[i], LuftNewMarker {}) T(MoveIfPossible(Elements[i]));
+					Elements[i].~T();
+				}
+			}
+			Elements = resized;
+		}
+		else if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			Elements = static_cast<T*>(AllocatorPolicy::Reallocate(Elements, Capacity * sizeof(T), totalSize, alignof(T)));
+		}
+		else if (!AllocatorPolicy::TryExpandInPlace(Elements, Capacity * sizeof(T), totalSize, alignof(T)))
+		{
+			T* resized = static_cast<T*>(AllocatorPolicy::Allocate(totalSize, alignof(T)));
 			for (usize i = 0; i < Count; ++i)
 			{
+				new (&resized[i], LuftNewMarker {}) T(MoveIfPossible(Elements[i]));
 				Elements[i].~T();
 			}
+			AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
+
+			Elements = resized;
 		}
-		Allocator->Deallocate(Elements, Capacity * sizeof(T));
 
-		Elements = resized;
 		Capacity = totalCapacity;
 	}
 
 	T* Elements;
 	usize Count;
 	usize Capacity;
-	Allocator* Allocator;
+	alignas(T) uint8 InlineStorage[N * sizeof(T)];
 };
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Base.hpp"
+
+#if PLATFORM_WINDOWS
+#include <intrin.h>
+#endif
+
+template<typename T>
+class Atomic
+{
+public:
+	static_assert(sizeof(T) == sizeof(int8) || sizeof(T) == sizeof(int32) || sizeof(T) == sizeof(int64));
+
+	constexpr Atomic()
+		: Value {}
+	{
+	}
+
+	constexpr explicit Atomic(T value)
+		: Value(value)
+	{
+	}
+
+	Atomic(const Atomic&) = delete;
+	Atomic& operator=(const Atomic&) = delete;
+
+	T Load() const
+	{
+		const T value = *static_cast<const volatile T*>(&Value);
+		_ReadWriteBarrier();
+		return value;
+	}
+
+	void Store(T value)
+	{
+		_ReadWriteBarrier();
+		*static_cast<volatile T*>(&Value) = value;
+	}
+
+	T Exchange(T value)
+	{
+		if constexpr (sizeof(T) == sizeof(int8))
+		{
+			return FromInteger(_InterlockedExchange8(AsInteger<char>(), ToInteger<char>(value)));
+		}
+		else if constexpr (sizeof(T) == sizeof(int32))
+		{
+			return FromInteger(_InterlockedExchange(AsInteger<long>(), ToInteger<long>(value)));
+		}
+		else
+		{
+			return FromInteger(_InterlockedExchange64(AsInteger<int64>(), ToInteger<int64>(value)));
+		}
+	}
+
+	bool CompareExchange(T* expected, T desired)
+	{
+		if constexpr (sizeof(T) == sizeof(int8))
+		{
+			const char expectedInteger = ToInteger<char>(*expected);
+			const char previous = _InterlockedCompareExchange8(AsInteger<char>(), ToInteger<char>(desired), expectedInteger);
+			*expected = FromInteger(previous);
+			return previous == expectedInteger;
+		}
+		else if constexpr (sizeof(T) == sizeof(int32))
+		{
+			const long expectedInteger = ToInteger<long>(*expected);
+			const long previous = _InterlockedCompareExchange(AsInteger<long>(), ToInteger<long>(desired), expectedInteger);
+			*expected = FromInteger(previous);
+			return previous == expectedInteger;
+		}
+		else
+		{
+			const int64 expectedInteger = ToInteger<int64>(*expected);
+			const int64 previous = _InterlockedCompareExchange64(AsInteger<int64>(), ToInteger<int64>(desired), expectedInteger);
+			*expected = FromInteger(previous);
+			return previous == expectedInteger;
+		}
+	}
+
+	T FetchAdd(T value)
+	{
+		static_assert(sizeof(T) != sizeof(int8));
+		if constexpr (sizeof(T) == sizeof(int32))
+		{
+			return FromInteger(_InterlockedExchangeAdd(AsInteger<long>(), ToInteger<long>(value)));
+		}
+		else
+		{
+			return FromInteger(_InterlockedExchangeAdd64(AsInteger<int64>(), ToInteger<int64>(value)));
+		}
+	}
+
+	T FetchSub(T value)
+	{
+		return FetchAdd(static_cast<T>(0 - value));
+	}
+
+private:
+	template<typename I>
+	volatile I* AsInteger()
+	{
+		return reinterpret_cast<volatile I*>(&Value);
+	}
+
+	template<typename I>
+	static I ToInteger(T value)
+	{
+		return __builtin_bit_cast(I, value);
+	}
+
+	template<typename I>
+	static T FromInteger(I integer)
+	{
+		return __builtin_bit_cast(T, integer);
+	}
+
+	T Value;
+};
@@ -0,0 +1,486 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+enum class BitOperation : uint8
+{
+	And,
+	Or,
+	Xor,
+	AndNot,
+};
+
+template<BitOperation Operation>
+uint64 ApplyBitOperation(uint64 a, uint64 b)
+{
+	if constexpr (Operation == BitOperation::And)
+	{
+		return a & b;
+	}
+	else if constexpr (Operation == BitOperation::Or)
+	{
+		return a | b;
+	}
+	else if constexpr (Operation == BitOperation::Xor)
+	{
+		return a ^ b;
+	}
+	else
+	{
+		return a & ~b;
+	}
+}
+
+template<BitOperation Operation>
+void ApplyBitOperation(uint64* destination, const uint64* source, usize wordCount)
+{
+	usize i = 0;
+#if defined(__AVX2__)
+	for (; i + 4 <= wordCount; i += 4)
+	{
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+
+		__m256i result;
+		if constexpr (Operation == BitOperation::And)
+		{
+			result = _mm256_and_si256(a, b);
+		}
+		else if constexpr (Operation == BitOperation::Or)
+		{
+			result = _mm256_or_si256(a, b);
+		}
+		else if constexpr (Operation == BitOperation::Xor)
+		{
+			result = _mm256_xor_si256(a, b);
+		}
+		else
+		{
+			result = _mm256_andnot_si256(b, a);
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), result);
+	}
+#endif
+	for (; i < wordCount; ++i)
+	{
+		destination[i] = ApplyBitOperation<Operation>(destination[i], source[i]);
+	}
+}
+
+inline usize CountSetBits(const uint64* words, usize wordCount)
+{
+	usize count = 0;
+	for (usize i = 0; i < wordCount; ++i)
+	{
+		count += CountSetBits(words[i]);
+	}
+	return count;
+}
+
+inline usize FindFirstSetBit(const uint64* words, usize wordCount)
+{
+	for (usize i = 0; i < wordCount; ++i)
+	{
+		if (words[i] != 0)
+		{
+			return i * 64 + CountTrailingZeros(words[i]);
+		}
+	}
+	return INDEX_NONE;
+}
+
+inline bool IsAnyBitSet(const uint64* words, usize wordCount)
+{
+	usize i = 0;
+#if defined(__AVX2__)
+	for (; i + 4 <= wordCount; i += 4)
+	{
+		const __m256i word = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+		if (!_mm256_testz_si256(word, word))
+		{
+			return true;
+		}
+	}
+#endif
+	for (; i < wordCount; ++i)
+	{
+		if (words[i] != 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+class SetBitIterator
+{
+public:
+	SetBitIterator(const uint64* words, usize wordCount, usize wordIndex)
+		: Words(words)
+		, WordCount(wordCount)
+		, WordIndex(wordIndex)
+		, Word(wordIndex < wordCount ? words[wordIndex] : 0)
+	{
+		SkipEmptyWords();
+	}
+
+	usize operator*() const
+	{
+		return WordIndex * 64 + CountTrailingZeros(Word);
+	}
+
+	SetBitIterator& operator++()
+	{
+		Word &= Word - 1;
+		SkipEmptyWords();
+		return *this;
+	}
+
+	bool operator==(const SetBitIterator& rhs) const
+	{
+		return WordIndex == rhs.WordIndex && Word == rhs.Word;
+	}
+
+private:
+	void SkipEmptyWords()
+	{
+		while (Word == 0 && WordIndex < WordCount)
+		{
+			++WordIndex;
+			Word = WordIndex < WordCount ? Words[WordIndex] : 0;
+		}
+	}
+
+	const uint64* Words;
+	usize WordCount;
+	usize WordIndex;
+	uint64 Word;
+};
+
+template<usize N>
+class BitSet
+{
+public:
+	static constexpr usize WordCount = (N + 63) / 64;
+
+	constexpr BitSet()
+		: Words {}
+	{
+	}
+
+	bool operator[](usize index) const
+	{
+		return Test(index);
+	}
+
+	bool operator==(const BitSet& rhs) const
+	{
+		for (usize i = 0; i < WordCount; ++i)
+		{
+			if (Words[i] != rhs.Words[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	BitSet& operator&=(const BitSet& rhs)
+	{
+		ApplyBitOperation<BitOperation::And>(Words, rhs.Words, WordCount);
+		return *this;
+	}
+
+	BitSet& operator|=(const BitSet& rhs)
+	{
+		ApplyBitOperation<BitOperation::Or>(Words, rhs.Words, WordCount);
+		return *this;
+	}
+
+	BitSet& operator^=(const BitSet& rhs)
+	{
+		ApplyBitOperation<BitOperation::Xor>(Words, rhs.Words, WordCount);
+		return *this;
+	}
+
+	BitSet& AndNot(const BitSet& rhs)
+	{
+		ApplyBitOperation<BitOperation::AndNot>(Words, rhs.Words, WordCount);
+		return *this;
+	}
+
+	static constexpr usize GetCount()
+	{
+		return N;
+	}
+
+	bool Test(usize index) const
+	{
+		CHECK(index < N);
+		return (Words[index / 64] >> (index % 64)) & 1;
+	}
+
+	void Set(usize index)
+	{
+		CHECK(index < N);
+		Words[index / 64] |= 1ull << (index % 64);
+	}
+
+	void Set(usize index, bool value)
+	{
+		if (value)
+		{
+			Set(index);
+		}
+		else
+		{
+			Clear(index);
+		}
+	}
+
+	void Clear(usize index)
+	{
+		CHECK(index < N);
+		Words[index / 64] &= ~(1ull << (index % 64));
+	}
+
+	void SetAll()
+	{
+		for (uint64& word : Words)
+		{
+			word = ~0ull;
+		}
+		if constexpr (N % 64 != 0)
+		{
+			Words[WordCount - 1] = (1ull << (N % 64)) - 1;
+		}
+	}
+
+	void ClearAll()
+	{
+		for (uint64& word : Words)
+		{
+			word = 0;
+		}
+	}
+
+	usize CountSetBits() const
+	{
+		return ::CountSetBits(Words, WordCount);
+	}
+
+	usize FindFirstSet() const
+	{
+		return FindFirstSetBit(Words, WordCount);
+	}
+
+	bool IsAnySet() const
+	{
+		return IsAnyBitSet(Words, WordCount);
+	}
+
+	const uint64* GetWords() const
+	{
+		return Words;
+	}
+
+	SetBitIterator begin() const
+	{
+		return SetBitIterator(Words, WordCount, 0);
+	}
+
+	SetBitIterator end() const
+	{
+		return SetBitIterator(Words, WordCount, WordCount);
+	}
+
+private:
+	uint64 Words[WordCount];
+};
+
+class BitArray
+{
+public:
+	BitArray()
+		: Words(&GlobalAllocator::Get())
+		, Count(0)
+	{
+	}
+
+	explicit BitArray(Allocator* allocator)
+		: Words(allocator)
+		, Count(0)
+	{
+	}
+
+	explicit BitArray(usize count, Allocator* allocator = &GlobalAllocator::Get())
+		: Words(allocator)
+		, Count(0)
+	{
+		Resize(count);
+	}
+
+	bool operator[](usize index) const
+	{
+		return Test(index);
+	}
+
+	BitArray& operator&=(const BitArray& rhs)
+	{
+		CHECK(Count == rhs.Count);
+		ApplyBitOperation<BitOperation::And>(Words.GetData(), rhs.Words.GetData(), Words.GetCount());
+		return *this;
+	}
+
+	BitArray& operator|=(const BitArray& rhs)
+	{
+		CHECK(Count == rhs.Count);
+		ApplyBitOperation<BitOperation::Or>(Words.GetData(), rhs.Words.GetData(), Words.GetCount());
+		return *this;
+	}
+
+	BitArray& operator^=(const BitArray& rhs)
+	{
+		CHECK(Count == rhs.Count);
+		ApplyBitOperation<BitOperation::Xor>(Words.GetData(), rhs.Words.GetData(), Words.GetCount());
+		return *this;
+	}
+
+	BitArray& AndNot(const BitArray& rhs)
+	{
+		CHECK(Count == rhs.Count);
+		ApplyBitOperation<BitOperation::AndNot>(Words.GetData(), rhs.Words.GetData(), Words.GetCount());
+		return *this;
+	}
+
+	usize GetCount() const
+	{
+		return Count;
+	}
+
+	bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	bool Test(usize index) const
+	{
+		CHECK(index < Count);
+		return (Words[index / 64] >> (index % 64)) & 1;
+	}
+
+	void Set(usize index)
+	{
+		CHECK(index < Count);
+		Words[index / 64] |= 1ull << (index % 64);
+	}
+
+	void Set(usize index, bool value)
+	{
+		if (value)
+		{
+			Set(index);
+		}
+		else
+		{
+			Clear(index);
+		}
+	}
+
+	void Clear(usize index)
+	{
+		CHECK(index < Count);
+		Words[index / 64] &= ~(1ull << (index % 64));
+	}
+
+	void Add(bool value)
+	{
+		Resize(Count + 1);
+		Set(Count - 1, value);
+	}
+
+	void Resize(usize newCount)
+	{
+		const usize newWordCount = (newCount + 63) / 64;
+		if (newCount < Count)
+		{
+			Words.Resize(newWordCount);
+			Count = newCount;
+			ClearTrailingBits();
+		}
+		else
+		{
+			Words.Resize(newWordCount, 0);
+			Count = newCount;
+		}
+	}
+
+	void SetAll()
+	{
+		for (uint64& word : Words)
+		{
+			word = ~0ull;
+		}
+		ClearTrailingBits();
+	}
+
+	void ClearAll()
+	{
+		for (uint64& word : Words)
+		{
+			word = 0;
+		}
+	}
+
+	usize CountSetBits() const
+	{
+		return ::CountSetBits(Words.GetData(), Words.GetCount());
+	}
+
+	usize FindFirstSet() const
+	{
+		return FindFirstSetBit(Words.GetData(), Words.GetCount());
+	}
+
+	bool IsAnySet() const
+	{
+		return IsAnyBitSet(Words.GetData(), Words.GetCount());
+	}
+
+	const uint64* GetWords() const
+	{
+		return Words.GetData();
+	}
+
+	SetBitIterator begin() const
+	{
+		return SetBitIterator(Words.GetData(), Words.GetCount(), 0);
+	}
+
+	SetBitIterator end() const
+	{
+		return SetBitIterator(Words.GetData(), Words.GetCount(), Words.GetCount());
+	}
+
+private:
+	// Bits past Count are kept cleared so word-level counts and scans stay correct.
+	void ClearTrailingBits()
+	{
+		if (Count % 64 != 0)
+		{
+			Words.Last() &= (1ull << (Count % 64)) - 1;
+		}
+	}
+
+	Array<uint64> Words;
+	usize Count;
+};
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+#include "Meta.hpp"
+#include "NoCopy.hpp"
+
+template<typename ChunkedArrayType, typename T>
+class ChunkedArrayIterator
+{
+public:
+	ChunkedArrayIterator(ChunkedArrayType* owner, usize index)
+		: Owner(owner)
+		, Index(index)
+	{
+	}
+
+	T& operator*() const { return (*Owner)[Index]; }
+	T* operator->() const { return &(*Owner)[Index]; }
+	ChunkedArrayIterator& operator++() { ++Index; return *this; }
+	bool operator==(const ChunkedArrayIterator& rhs) const { return Index == rhs.Index; }
+
+private:
+	ChunkedArrayType* Owner;
+	usize Index;
+};
+
+// Elements live in fixed-size chunks that are never moved, so pointers stay valid while the array grows.
+template<typename T, usize ChunkSize = 64, typename AllocatorPolicy = DynamicAllocatorPolicy>
+class ChunkedArray : public NoCopy, private AllocatorPolicy
+{
+public:
+	static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two!");
+
+	using AllocatorPolicy::GetAllocator;
+
+	ChunkedArray()
+		: AllocatorPolicy()
+		, Chunks()
+		, Count(0)
+	{
+	}
+
+	explicit ChunkedArray(Allocator* allocator)
+		: AllocatorPolicy(allocator)
+		, Chunks(allocator)
+		, Count(0)
+	{
+	}
+
+	~ChunkedArray()
+	{
+		if (AllocatorPolicy::HasAllocator())
+		{
+			Clear();
+			ShrinkToFit();
+		}
+		else
+		{
+			CHECK(Chunks.IsEmpty());
+		}
+
+		Count = 0;
+	}
+
+	ChunkedArray(ChunkedArray&& move) noexcept
+		: AllocatorPolicy(Move(move))
+		, Chunks(Move(move.Chunks))
+		, Count(move.Count)
+	{
+		move.Count = 0;
+	}
+
+	ChunkedArray& operator=(ChunkedArray&& move) noexcept
+	{
+		if (&move == this)
+		{
+			return *this;
+		}
+
+		this->~ChunkedArray();
+
+		Chunks = Move(move.Chunks);
+		Count = move.Count;
+		AllocatorPolicy::operator=(Move(move));
+
+		move.Count = 0;
+
+		return *this;
+	}
+
+	T& operator[](usize index)
+	{
+		CHECK(index < Count);
+		return Chunks[index / ChunkSize][index % ChunkSize];
+	}
+
+	const T& operator[](usize index) const
+	{
+		CHECK(index < Count);
+		return Chunks[index / ChunkSize][index % ChunkSize];
+	}
+
+	T& First()
+	{
+		CHECK(!IsEmpty());
+		return (*this)[0];
+	}
+
+	const T& First() const
+	{
+		CHECK(!IsEmpty());
+		return (*this)[0];
+	}
+
+	T& Last()
+	{
+		CHECK(!IsEmpty());
+		return (*this)[Count - 1];
+	}
+
+	const T& Last() const
+	{
+		CHECK(!IsEmpty());
+		return (*this)[Count - 1];
+	}
+
+	usize GetCount() const
+	{
+		return Count;
+	}
+
+	usize GetCapacity() const
+	{
+		return Chunks.GetCount() * ChunkSize;
+	}
+
+	bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	T& Add(const T& newElement)
+	{
+		return Emplace(newElement);
+	}
+
+	T& Add(T&& newElement)
+	{
+		return Emplace(Move(newElement));
+	}
+
+	template<typename... Args>
+	T& Emplace(Args&&... args)
+	{
+		if (Count == GetCapacity())
+		{
+			AddChunk();
+		}
+
+		T* element = &Chunks[Count / ChunkSize][Count % ChunkSize];
+		new (element, LuftNewMarker {}) T(Forward<Args>(args)...);
+		++Count;
+		return *element;
+	}
+
+	void Reserve(usize totalCapacity)
+	{
+		while (GetCapacity() < totalCapacity)
+		{
+			AddChunk();
+		}
+	}
+
+	void RemoveLast()
+	{
+		CHECK(!IsEmpty());
+		Last().~T();
+		--Count;
+	}
+
+	void Truncate(usize newCount)
+	{
+		CHECK(newCount <= Count);
+		if constexpr (!IsTriviallyDestructible<T>::Value)
+		{
+			for (usize i = newCount; i < Count; ++i)
+			{
+				(*this)[i].~T();
+			}
+		}
+		Count = newCount;
+	}
+
+	void Clear()
+	{
+		Truncate(0);
+	}
+
+	void ShrinkToFit()
+	{
+		const usize usedChunkCount = (Count + ChunkSize - 1) / ChunkSize;
+		while (Chunks.GetCount() > usedChunkCount)
+		{
+			AllocatorPolicy::Deallocate(Chunks.Last(), ChunkSize * sizeof(T), alignof(T));
+			Chunks.Remove(Chunks.GetCount() - 1);
+		}
+	}
+
+	usize GetChunkCount() const
+	{
+		return (Count + ChunkSize - 1) / ChunkSize;
+	}
+
+	T* GetChunkData(usize chunkIndex) const
+	{
+		CHECK(chunkIndex < GetChunkCount());
+		return Chunks[chunkIndex];
+	}
+
+	usize GetChunkElementCount(usize chunkIndex) const
+	{
+		CHECK(chunkIndex < GetChunkCount());
+		const usize remaining = Count - chunkIndex * ChunkSize;
+		return remaining < ChunkSize ? remaining : ChunkSize;
+	}
+
+	ArrayView<T> GetChunk(usize chunkIndex) const
+	{
+		return ArrayView<T>(GetChunkData(chunkIndex), GetChunkElementCount(chunkIndex));
+	}
+
+	ChunkedArrayIterator<ChunkedArray, T> begin()
+	{
+		return ChunkedArrayIterator<ChunkedArray, T>(this, 0);
+	}
+
+	ChunkedArrayIterator<ChunkedArray, T> end()
+	{
+		return ChunkedArrayIterator<ChunkedArray, T>(this, Count);
+	}
+
+	ChunkedArrayIterator<const ChunkedArray, const T> begin() const
+	{
+		return ChunkedArrayIterator<const ChunkedArray, const T>(this, 0);
+	}
+
+	ChunkedArrayIterator<const ChunkedArray, const T> end() const
+	{
+		return ChunkedArrayIterator<const ChunkedArray, const T>(this, Count);
+	}
+
+private:
+	void AddChunk()
+	{
+		Chunks.Add(static_cast<T*>(AllocatorPolicy::Allocate(ChunkSize * sizeof(T), alignof(T))));
+	}
+
+	Array<T*, AllocatorPolicy> Chunks;
+	usize Count;
+};
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Atomic.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+#include "Hash.hpp"
+#include "HashTable.hpp"
+#include "Math.hpp"
+#include "Mutex.hpp"
+#include "NoCopy.hpp"
+
+// Lookups never lock. Nodes are published fully constructed and never move or get freed while the table lives.
+template<typename K, typename V> requires IsEqualable<K> && IsHashable<K, Hash<K>>
+class ConcurrentHashTable : public NoCopy
+{
+public:
+	static constexpr usize DefaultShardCount = 64;
+	static constexpr usize MaxShardCount = 256;
+
+	explicit ConcurrentHashTable(usize shardCount = DefaultShardCount, Allocator* allocator = &GlobalAllocator::Get())
+		: Shards(nullptr)
+		, ShardCount(shardCount)
+		, NodeAllocator(allocator)
+	{
+		CHECK(IsPowerOfTwo(shardCount) && shardCount <= MaxShardCount);
+
+		Shards = static_cast<Shard*>(NodeAllocator->Allocate(ShardCount * sizeof(Shard), alignof(Shard)));
+		for (usize i = 0; i < ShardCount; ++i)
+		{
+			new (&Shards[i], LuftNewMarker {}) Shard {};
+		}
+	}
+
+	~ConcurrentHashTable()
+	{
+		for (usize i = 0; i < ShardCount; ++i)
+		{
+			Shard& shard = Shards[i];
+
+			// Retired slot arrays point at the same nodes, so only the current one owns them.
+			if (Table* table = shard.Current.Load())
+			{
+				for (usize j = 0; j < table->Capacity; ++j)
+				{
+					if (Node* node = table->Slots[j].Load())
+					{
+						node->~Node();
+						NodeAllocator->Deallocate(node, sizeof(Node), alignof(Node));
+					}
+				}
+				FreeTable(table);
+			}
+
+			Table* retired = shard.Retired;
+			while (retired)
+			{
+				Table* next = retired->NextRetired;
+				FreeTable(retired);
+				retired = next;
+			}
+
+			shard.~Shard();
+		}
+		NodeAllocator->Deallocate(Shards, ShardCount * sizeof(Shard), alignof(Shard));
+
+		Shards = nullptr;
+		ShardCount = 0;
+		NodeAllocator = nullptr;
+	}
+
+	Allocator* GetAllocator() const
+	{
+		return NodeAllocator;
+	}
+
+	// Sums the per-shard counts, so it is exact only while no thread is adding.
+	usize GetCount() const
+	{
+		usize count = 0;
+		for (usize i = 0; i < ShardCount; ++i)
+		{
+			count += Shards[i].Count.Load();
+		}
+		return count;
+	}
+
+	template<typename InputK>
+	bool Contains(const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		return Find(key) != nullptr;
+	}
+
+	template<typename InputK>
+	V* Find(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		const uint64 hash = Hash<InputK>{}(key);
+		Node* node = FindNode(GetShard(hash).Current.Load(), key, hash);
+		return node ? &node->Value : nullptr;
+	}
+
+	template<typename InputK>
+	const V* Find(const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		const uint64 hash = Hash<InputK>{}(key);
+		const Node* node = FindNode(GetShard(hash).Current.Load(), key, hash);
+		return node ? &node->Value : nullptr;
+	}
+
+	// Only the thread that inserts the key constructs the value from args, every other caller gets that value back.
+	template<typename InputK, typename... Args>
+	V& GetOrAdd(const InputK& key, Args&&... args) requires IsValidHashTableKey<K, InputK>
+	{
+		const uint64 hash = Hash<InputK>{}(key);
+		Shard& shard = GetShard(hash);
+
+		if (Node* node = FindNode(shard.Current.Load(), key, hash))
+		{
+			return node->Value;
+		}
+
+		MutexLock lock(&shard.WriteLock);
+
+		Table* table = shard.Current.Load();
+		if (Node* node = FindNode(table, key, hash))
+		{
+			return node->Value;
+		}
+
+		const usize count = shard.Count.Load() + 1;
+		if (!table || count > GetMaxLoad(table->Capacity))
+		{
+			table = Grow(shard, table);
+		}
+
+		Node* node = static_cast<Node*>(NodeAllocator->Allocate(sizeof(Node), alignof(Node)));
+		if constexpr (IsSame<RemoveCvType<InputK>, StringView>::Value)
+		{
+			new (node, LuftNewMarker {}) Node { hash, String(key, NodeAllocator), V(Forward<Args>(args)...) };
+		}
+		else
+		{
+			new (node, LuftNewMarker {}) Node { hash, key, V(Forward<Args>(args)...) };
+		}
+
+		// Publishing the node is the last step, so readers only ever see it fully constructed.
+		Insert(table, node);
+		shard.Count.Store(count);
+
+		return node->Value;
+	}
+
+private:
+	struct Node
+	{
+		uint64 Hash;
+		K Key;
+		V Value;
+	};
+
+	struct Table
+	{
+		Table* NextRetired;
+		usize Capacity;
+		Atomic<Node*>* Slots;
+	};
+
+	struct alignas(64) Shard
+	{
+		Mutex WriteLock;
+		Atomic<Table*> Current;
+		Atomic<usize> Count;
+		Table* Retired;
+	};
+
+	static constexpr usize MinCapacity = 16;
+
+	static usize GetMaxLoad(usize capacity)
+	{
+		return capacity / 2;
+	}
+
+	template<typename InputK>
+	static Node* FindNode(Table* table, const InputK& key, uint64 hash)
+	{
+		if (!table)
+		{
+			return nullptr;
+		}
+
+		const usize mask = table->Capacity - 1;
+		for (usize index = hash & mask;; index = (index + 1) & mask)
+		{
+			Node* node = table->Slots[index].Load();
+			if (!node)
+			{
+				return nullptr;
+			}
+			if (node->Hash == hash && key == node->Key)
+			{
+				return node;
+			}
+		}
+	}
+
+	static void Insert(Table* table, Node* node)
+	{
+		const usize mask = table->Capacity - 1;
+		usize index = node->Hash & mask;
+		while (table->Slots[index].Load())
+		{
+			index = (index + 1) & mask;
+		}
+		table->Slots[index].Store(node);
+	}
+
+	Shard& GetShard(uint64 hash) const
+	{
+		return Shards[(hash >> 56) & (ShardCount - 1)];
+	}
+
+	Table* Grow(Shard& shard, Table* table)
+	{
+		const usize capacity = table ? table->Capacity * 2 : MinCapacity;
+
+		Table* grown = static_cast<Table*>(NodeAllocator->Allocate(sizeof(Table) + capacity * sizeof(Atomic<Node*>), alignof(Table)));
+		grown->NextRetired = nullptr;
+		grown->Capacity = capacity;
+		grown->Slots = reinterpret_cast<Atomic<Node*>*>(grown + 1);
+		for (usize i = 0; i < capacity; ++i)
+		{
+			new (&grown->Slots[i], LuftNewMarker {}) Atomic<Node*>();
+		}
+
+		if (table)
+		{
+			for (usize i = 0; i < table->Capacity; ++i)
+			{
+				if (Node* node = table->Slots[i].Load())
+				{
+					Insert(grown, node);
+				}
+			}
+
+			table->NextRetired = shard.Retired;
+			shard.Retired = table;
+		}
+
+		shard.Current.Store(grown);
+		return grown;
+	}
+
+	void FreeTable(Table* table)
+	{
+		NodeAllocator->Deallocate(table, sizeof(Table) + table->Capacity * sizeof(Atomic<Node*>), alignof(Table));
+	}
+
+	Shard* Shards;
+	usize ShardCount;
+	Allocator* NodeAllocator;
+};
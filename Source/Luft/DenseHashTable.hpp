@@ -0,0 +1,229 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Hash.hpp"
+#include "HashIndex.hpp"
+#include "HashTable.hpp"
+
+template<typename K, typename V, typename AllocatorPolicy = DynamicAllocatorPolicy> requires IsEqualable<K> && IsHashable<K, Hash<K>>
+class DenseHashTable
+{
+public:
+	using Pair = HashTablePair<K, V>;
+
+	DenseHashTable()
+		: Pairs()
+		, Index()
+	{
+	}
+
+	explicit DenseHashTable(Allocator* allocator)
+		: Pairs(allocator)
+		, Index(allocator)
+	{
+	}
+
+	explicit DenseHashTable(usize capacity, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: Pairs(capacity, allocator)
+		, Index(allocator)
+	{
+		Index.Reserve(capacity, 0);
+	}
+
+	template<typename InputK>
+	V& operator[](const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		return Get(key);
+	}
+
+	template<typename InputK>
+	const V& operator[](const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		return Get(key);
+	}
+
+	Allocator* GetAllocator() const
+	{
+		return Pairs.GetAllocator();
+	}
+
+	usize GetCount() const
+	{
+		return Pairs.GetCount();
+	}
+
+	bool IsEmpty() const
+	{
+		return Pairs.IsEmpty();
+	}
+
+	ArrayView<Pair> GetPairs() const
+	{
+		return Pairs;
+	}
+
+	void Reserve(usize count)
+	{
+		Pairs.Reserve(count);
+		Index.Reserve(count, Pairs.GetCount());
+	}
+
+	template<typename InputK>
+	bool Contains(const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		return FindIndex(key, Hash<InputK>{}(key)) != INDEX_NONE;
+	}
+
+	template<typename InputK>
+	V& Get(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		const usize index = FindIndex(key, Hash<InputK>{}(key));
+		CHECK(index != INDEX_NONE);
+		return Pairs[index].Value;
+	}
+
+	template<typename InputK>
+	const V& Get(const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		const usize index = FindIndex(key, Hash<InputK>{}(key));
+		CHECK(index != INDEX_NONE);
+		return Pairs[index].Value;
+	}
+
+	template<typename InputK>
+	V* Find(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		const usize index = FindIndex(key, Hash<InputK>{}(key));
+		return index != INDEX_NONE ? &Pairs[index].Value : nullptr;
+	}
+
+	template<typename InputK>
+	const V* Find(const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		const usize index = FindIndex(key, Hash<InputK>{}(key));
+		return index != INDEX_NONE ? &Pairs[index].Value : nullptr;
+	}
+
+	template<typename InputK>
+	V& GetOrAdd(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		const uint64 hash = Hash<InputK>{}(key);
+		const usize index = FindIndex(key, hash);
+		if (index != INDEX_NONE)
+		{
+			return Pairs[index].Value;
+		}
+
+		Index.Add(hash, Pairs.GetCount(), Pairs.GetCount());
+		if constexpr (IsSame<RemoveCvType<InputK>, StringView>::Value)
+		{
+			Pairs.Add(Pair { String(key, GetAllocator()), {} });
+		}
+		else
+		{
+			Pairs.Add(Pair { key, {} });
+		}
+		return Pairs.Last().Value;
+	}
+
+	V& GetOrAdd(K&& key)
+	{
+		const uint64 hash = Hash<K>{}(key);
+		const usize index = FindIndex(key, hash);
+		if (index != INDEX_NONE)
+		{
+			return Pairs[index].Value;
+		}
+
+		Index.Add(hash, Pairs.GetCount(), Pairs.GetCount());
+		Pairs.Add(Pair { Move(key), {} });
+		return Pairs.Last().Value;
+	}
+
+	bool Add(const K& key, const V& value)
+	{
+		const uint64 hash = Hash<K>{}(key);
+		const usize index = FindIndex(key, hash);
+		if (index != INDEX_NONE)
+		{
+			Pairs[index] = Pair { key, value };
+			return false;
+		}
+
+		Index.Add(hash, Pairs.GetCount(), Pairs.GetCount());
+		Pairs.Add(Pair { key, value });
+		return true;
+	}
+
+	bool Add(K&& key, V&& value)
+	{
+		const uint64 hash = Hash<K>{}(key);
+		const usize index = FindIndex(key, hash);
+		if (index != INDEX_NONE)
+		{
+			Pairs[index] = Pair { Move(key), Move(value) };
+			return false;
+		}
+
+		Index.Add(hash, Pairs.GetCount(), Pairs.GetCount());
+		Pairs.Add(Pair { Move(key), Move(value) });
+		return true;
+	}
+
+	template<typename InputK>
+	void Remove(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		const uint64 hash = Hash<InputK>{}(key);
+		const usize index = FindIndex(key, hash);
+		CHECK(index != INDEX_NONE);
+
+		Index.Remove(hash, index);
+
+		const usize last = Pairs.GetCount() - 1;
+		if (index != last)
+		{
+			Index.Reassign(Hash<K>{}(Pairs[last].Key), last, index);
+		}
+		Pairs.RemoveSwap(index);
+	}
+
+	void Clear()
+	{
+		Pairs.Clear();
+		Index.Clear();
+	}
+
+	ArrayIterator<Pair> begin()
+	{
+		return Pairs.begin();
+	}
+
+	ArrayIterator<Pair> end()
+	{
+		return Pairs.end();
+	}
+
+	ArrayIterator<const Pair> begin() const
+	{
+		return Pairs.begin();
+	}
+
+	ArrayIterator<const Pair> end() const
+	{
+		return Pairs.end();
+	}
+
+private:
+	template<typename InputK>
+	usize FindIndex(const InputK& key, uint64 hash) const
+	{
+		return Index.Find(hash, [this, &key](usize index) { return key == Pairs[index].Key; });
+	}
+
+	Array<Pair, AllocatorPolicy> Pairs;
+	HashIndex<AllocatorPolicy> Index;
+};
+
+template<typename K, typename V, typename AllocatorPolicy>
+struct IsTriviallyRelocatable<DenseHashTable<K, V, AllocatorPolicy>> : TrueConstant {};
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+#include "HashTable.hpp"
+#include "Math.hpp"
+
+// Each slot keeps the low 32 bits of its entry's hash, so growing never has to look at the entries themselves.
+// Key comparisons are left to the caller through a predicate on the entry index.
+template<typename AllocatorPolicy = DynamicAllocatorPolicy>
+class HashIndex : private AllocatorPolicy
+{
+public:
+	using AllocatorPolicy::GetAllocator;
+
+	HashIndex()
+		: AllocatorPolicy()
+		, Controls(nullptr)
+		, Slots(nullptr)
+		, Capacity(0)
+		, GrowthLeft(0)
+	{
+	}
+
+	explicit HashIndex(Allocator* allocator)
+		: AllocatorPolicy(allocator)
+		, Controls(nullptr)
+		, Slots(nullptr)
+		, Capacity(0)
+		, GrowthLeft(0)
+	{
+	}
+
+	~HashIndex()
+	{
+		if (Controls)
+		{
+			AllocatorPolicy::Deallocate(Controls, GetAllocationSize(Capacity), HashTableGroup::Width);
+		}
+		Controls = nullptr;
+		Slots = nullptr;
+		Capacity = 0;
+		GrowthLeft = 0;
+	}
+
+	HashIndex(const HashIndex& copy)
+		: AllocatorPolicy(copy)
+		, Controls(nullptr)
+		, Slots(nullptr)
+		, Capacity(0)
+		, GrowthLeft(0)
+	{
+		CopyFrom(copy);
+	}
+
+	HashIndex& operator=(const HashIndex& copy)
+	{
+		if (&copy == this)
+		{
+			return *this;
+		}
+
+		this->~HashIndex();
+
+		AllocatorPolicy::operator=(copy);
+		CopyFrom(copy);
+
+		return *this;
+	}
+
+	HashIndex(HashIndex&& move) noexcept
+		: AllocatorPolicy(Move(move))
+		, Controls(move.Controls)
+		, Slots(move.Slots)
+		, Capacity(move.Capacity)
+		, GrowthLeft(move.GrowthLeft)
+	{
+		move.Controls = nullptr;
+		move.Slots = nullptr;
+		move.Capacity = 0;
+		move.GrowthLeft = 0;
+	}
+
+	HashIndex& operator=(HashIndex&& move) noexcept
+	{
+		if (&move == this)
+		{
+			return *this;
+		}
+
+		this->~HashIndex();
+
+		Controls = move.Controls;
+		Slots = move.Slots;
+		Capacity = move.Capacity;
+		GrowthLeft = move.GrowthLeft;
+		AllocatorPolicy::operator=(Move(move));
+
+		move.Controls = nullptr;
+		move.Slots = nullptr;
+		move.Capacity = 0;
+		move.GrowthLeft = 0;
+
+		return *this;
+	}
+
+	usize GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	template<typename Predicate>
+	usize Find(uint64 hash, const Predicate& isMatch) const
+	{
+		const uint32 shortHash = static_cast<uint32>(hash);
+		const usize index = FindHashTableIndex(Controls, Capacity, shortHash, [this, shortHash, &isMatch](usize slot) { return Slots[slot].ShortHash == shortHash && isMatch(Slots[slot].Entry); });
+		return index != INDEX_NONE ? Slots[index].Entry : INDEX_NONE;
+	}
+
+	// The caller guarantees no equal entry is indexed yet. Grows at 7/8 load.
+	void Add(uint64 hash, usize entry, usize entryCount)
+	{
+		CHECK(entry < UINT32_MAX);
+
+		const uint32 shortHash = static_cast<uint32>(hash);
+		usize index = Capacity > 0 ? FindHashTableInsertIndex(Controls, Capacity, shortHash) : INDEX_NONE;
+		if (index == INDEX_NONE || (GrowthLeft == 0 && Controls[index] == HashTableGroup::Empty))
+		{
+			Rehash(GetHashTableRehashCapacity(entryCount, Capacity), entryCount);
+			index = FindHashTableInsertIndex(Controls, Capacity, shortHash);
+		}
+
+		if (Controls[index] == HashTableGroup::Empty)
+		{
+			--GrowthLeft;
+		}
+		Controls[index] = GetHashTableTag(shortHash);
+		Slots[index] = Slot { static_cast<uint32>(entry), shortHash };
+	}
+
+	void Remove(uint64 hash, usize entry)
+	{
+		if (EraseHashTableSlot(Controls, FindSlot(static_cast<uint32>(hash), entry)))
+		{
+			++GrowthLeft;
+		}
+	}
+
+	void Reassign(uint64 hash, usize oldEntry, usize newEntry)
+	{
+		Slots[FindSlot(static_cast<uint32>(hash), oldEntry)].Entry = static_cast<uint32>(newEntry);
+	}
+
+	void Reserve(usize count, usize entryCount)
+	{
+		if (count > entryCount + GrowthLeft)
+		{
+			Rehash(GetHashTableCapacityForCount(Max(count, entryCount)), entryCount);
+		}
+	}
+
+	void Clear()
+	{
+		if (Controls)
+		{
+			Platform::MemorySet(Controls, HashTableGroup::Empty, Capacity);
+		}
+		GrowthLeft = GetHashTableMaxLoad(Capacity);
+	}
+
+	void Prefetch(uint64 hash) const
+	{
+		if (Capacity == 0)
+		{
+			return;
+		}
+
+		const usize groupMask = Capacity / HashTableGroup::Width - 1;
+		const usize groupStart = (GetHashTableFirstGroup(static_cast<uint32>(hash)) & groupMask) * HashTableGroup::Width;
+		_mm_prefetch(reinterpret_cast<const char*>(Controls + groupStart), _MM_HINT_T0);
+		_mm_prefetch(reinterpret_cast<const char*>(Slots + groupStart), _MM_HINT_T0);
+	}
+
+private:
+	struct Slot
+	{
+		uint32 Entry;
+		uint32 ShortHash;
+	};
+
+	static usize GetAllocationSize(usize capacity)
+	{
+		return capacity + capacity * sizeof(Slot);
+	}
+
+	usize FindSlot(uint32 shortHash, usize entry) const
+	{
+		const usize index = FindHashTableIndex(Controls, Capacity, shortHash, [this, entry](usize slot) { return Slots[slot].Entry == entry; });
+		CHECK(index != INDEX_NONE);
+		return index;
+	}
+
+	void Rehash(usize newCapacity, usize entryCount)
+	{
+		uint8* oldControls = Controls;
+		Slot* oldSlots = Slots;
+		const usize oldCapacity = Capacity;
+
+		// The slots are 4-byte aligned and the control bytes a multiple of 16 long, so they can follow directly.
+		uint8* memory = static_cast<uint8*>(AllocatorPolicy::Allocate(GetAllocationSize(newCapacity), HashTableGroup::Width));
+		Platform::MemorySet(memory, HashTableGroup::Empty, newCapacity);
+
+		Controls = memory;
+		Slots = reinterpret_cast<Slot*>(memory + newCapacity);
+		Capacity = newCapacity;
+		GrowthLeft = GetHashTableMaxLoad(newCapacity) - entryCount;
+
+		for (usize i = FindNextFullSlot(oldControls, oldCapacity, 0); i < oldCapacity; i = FindNextFullSlot(oldControls, oldCapacity, i + 1))
+		{
+			const usize index = FindHashTableInsertIndex(Controls, Capacity, oldSlots[i].ShortHash);
+			Controls[index] = oldControls[i];
+			Slots[index] = oldSlots[i];
+		}
+
+		if (oldControls)
+		{
+			AllocatorPolicy::Deallocate(oldControls, GetAllocationSize(oldCapacity), HashTableGroup::Width);
+		}
+	}
+
+	void CopyFrom(const HashIndex& copy)
+	{
+		if (copy.Capacity == 0)
+		{
+			return;
+		}
+
+		Controls = static_cast<uint8*>(AllocatorPolicy::Allocate(GetAllocationSize(copy.Capacity), HashTableGroup::Width));
+		Slots = reinterpret_cast<Slot*>(Controls + copy.Capacity);
+		Capacity = copy.Capacity;
+		GrowthLeft = copy.GrowthLeft;
+		Platform::MemoryCopy(Controls, copy.Controls, GetAllocationSize(Capacity));
+	}
+
+	uint8* Controls;
+	Slot* Slots;
+	usize Capacity;
+	usize GrowthLeft;
+};
+
+template<typename AllocatorPolicy>
+struct IsTriviallyRelocatable<HashIndex<AllocatorPolicy>> : TrueConstant {};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Hash.hpp"
+#include "HashIndex.hpp"
+#include "HashTable.hpp"
+
+template<typename K, typename AllocatorPolicy = DynamicAllocatorPolicy> requires IsEqualable<K> && IsHashable<K, Hash<K>>
+class HashSet
+{
+public:
+	HashSet()
+		: Keys()
+		, Index()
+	{
+	}
+
+	explicit HashSet(Allocator* allocator)
+		: Keys(allocator)
+		, Index(allocator)
+	{
+	}
+
+	explicit HashSet(usize capacity, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: Keys(capacity, allocator)
+		, Index(allocator)
+	{
+		Index.Reserve(capacity, 0);
+	}
+
+	Allocator* GetAllocator() const
+	{
+		return Keys.GetAllocator();
+	}
+
+	usize GetCount() const
+	{
+		return Keys.GetCount();
+	}
+
+	bool IsEmpty() const
+	{
+		return Keys.IsEmpty();
+	}
+
+	ArrayView<K> GetKeys() const
+	{
+		return Keys;
+	}
+
+	void Reserve(usize count)
+	{
+		Keys.Reserve(count);
+		Index.Reserve(count, Keys.GetCount());
+	}
+
+	template<typename InputK>
+	bool Contains(const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		return FindIndex(key, Hash<InputK>{}(key)) != INDEX_NONE;
+	}
+
+	template<typename InputK>
+	bool Add(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		const uint64 hash = Hash<InputK>{}(key);
+		if (FindIndex(key, hash) != INDEX_NONE)
+		{
+			return false;
+		}
+
+		Index.Add(hash, Keys.GetCount(), Keys.GetCount());
+		if constexpr (IsSame<RemoveCvType<InputK>, StringView>::Value)
+		{
+			Keys.Add(String(key, GetAllocator()));
+		}
+		else
+		{
+			Keys.Add(key);
+		}
+		return true;
+	}
+
+	bool Add(K&& key)
+	{
+		const uint64 hash = Hash<K>{}(key);
+		if (FindIndex(key, hash) != INDEX_NONE)
+		{
+			return false;
+		}
+
+		Index.Add(hash, Keys.GetCount(), Keys.GetCount());
+		Keys.Add(Move(key));
+		return true;
+	}
+
+	template<typename InputK>
+	void Remove(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		const uint64 hash = Hash<InputK>{}(key);
+		const usize index = FindIndex(key, hash);
+		CHECK(index != INDEX_NONE);
+
+		Index.Remove(hash, index);
+
+		const usize last = Keys.GetCount() - 1;
+		if (index != last)
+		{
+			Index.Reassign(Hash<K>{}(Keys[last]), last, index);
+		}
+		Keys.RemoveSwap(index);
+	}
+
+	void Clear()
+	{
+		Keys.Clear();
+		Index.Clear();
+	}
+
+	ArrayIterator<const K> begin() const
+	{
+		return Keys.begin();
+	}
+
+	ArrayIterator<const K> end() const
+	{
+		return Keys.end();
+	}
+
+private:
+	template<typename InputK>
+	usize FindIndex(const InputK& key, uint64 hash) const
+	{
+		return Index.Find(hash, [this, &key](usize index) { return key == Keys[index]; });
+	}
+
+	Array<K, AllocatorPolicy> Keys;
+	HashIndex<AllocatorPolicy> Index;
+};
+
+template<typename K, typename AllocatorPolicy>
+struct IsTriviallyRelocatable<HashSet<K, AllocatorPolicy>> : TrueConstant {};
@@ -3,74 +3,225 @@
 #include "Allocator.hpp"
 #include "Array.hpp"
 #include "Hash.hpp"
+#include "Math.hpp"
 
-template<typename BucketArray, typename Pair>
+#include <emmintrin.h>
+
+// Sixteen control bytes matched at once with SSE2. A full slot stores the low 7 bits of its key's hash,
+// empty and deleted slots have the high bit set.
+struct HashTableGroup
+{
+	static constexpr usize Width = 16;
+
+	static constexpr uint8 Empty = 0x80;
+	static constexpr uint8 Deleted = 0xFE;
+
+	explicit HashTableGroup(const uint8* controls)
+		: Controls(_mm_load_si128(reinterpret_cast<const __m128i*>(controls)))
+	{
+	}
+
+	uint32 Match(uint8 tag) const
+	{
+		return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(Controls, _mm_set1_epi8(static_cast<char>(tag)))));
+	}
+
+	uint32 MatchEmpty() const
+	{
+		return Match(Empty);
+	}
+
+	uint32 MatchEmptyOrDeleted() const
+	{
+		return static_cast<uint32>(_mm_movemask_epi8(Controls));
+	}
+
+	uint32 MatchFull() const
+	{
+		return ~MatchEmptyOrDeleted() & 0xFFFF;
+	}
+
+	__m128i Controls;
+};
+
+inline usize FindNextFullSlot(const uint8* controls, usize capacity, usize index)
+{
+	while (index < capacity)
+	{
+		const usize groupStart = index & ~(HashTableGroup::Width - 1);
+		const uint32 full = HashTableGroup(controls + groupStart).MatchFull() >> (index - groupStart);
+		if (full != 0)
+		{
+			return index + CountTrailingZeros(full);
+		}
+		index = groupStart + HashTableGroup::Width;
+	}
+	return capacity;
+}
+
+inline uint8 GetHashTableTag(uint64 hash)
+{
+	return static_cast<uint8>(hash & 0x7F);
+}
+
+inline usize GetHashTableFirstGroup(uint64 hash)
+{
+	return static_cast<usize>(hash >> 7);
+}
+
+// Keeps at least one slot in eight empty so every probe sequence ends.
+inline usize GetHashTableMaxLoad(usize capacity)
+{
+	return capacity - capacity / 8;
+}
+
+inline usize GetHashTableCapacityForCount(usize count)
+{
+	usize capacity = HashTableGroup::Width;
+	while (GetHashTableMaxLoad(capacity) < count)
+	{
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+inline usize GetHashTableRehashCapacity(usize count, usize capacity)
+{
+	return count + 1 > GetHashTableMaxLoad(capacity) / 2 ? Max(capacity * 2, HashTableGroup::Width) : capacity;
+}
+
+template<typename Predicate>
+usize FindHashTableIndex(const uint8* controls, usize capacity, uint64 hash, const Predicate& isMatch)
+{
+	if (capacity == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const usize groupMask = capacity / HashTableGroup::Width - 1;
+	const uint8 tag = GetHashTableTag(hash);
+
+	usize group = GetHashTableFirstGroup(hash) & groupMask;
+	for (usize step = 1;; ++step)
+	{
+		const usize groupStart = group * HashTableGroup::Width;
+		const HashTableGroup groupControls(controls + groupStart);
+
+		for (uint32 match = groupControls.Match(tag); match != 0; match &= match - 1)
+		{
+			const usize index = groupStart + CountTrailingZeros(match);
+			if (isMatch(index))
+			{
+				return index;
+			}
+		}
+
+		if (groupControls.MatchEmpty() != 0)
+		{
+			return INDEX_NONE;
+		}
+
+		group = (group + step) & groupMask;
+	}
+}
+
+inline usize FindHashTableInsertIndex(const uint8* controls, usize capacity, uint64 hash)
+{
+	const usize groupMask = capacity / HashTableGroup::Width - 1;
+
+	usize group = GetHashTableFirstGroup(hash) & groupMask;
+	for (usize step = 1;; ++step)
+	{
+		const usize groupStart = group * HashTableGroup::Width;
+		const uint32 available = HashTableGroup(controls + groupStart).MatchEmptyOrDeleted();
+		if (available != 0)
+		{
+			return groupStart + CountTrailingZeros(available);
+		}
+		group = (group + step) & groupMask;
+	}
+}
+
+// A probe only continues past a group that was full, so a group that still has an empty slot was never probed
+// through and the slot can go back to empty. Otherwise it has to stay a tombstone. Returns whether it became empty.
+inline bool EraseHashTableSlot(uint8* controls, usize index)
+{
+	const usize groupStart = index & ~(HashTableGroup::Width - 1);
+	if (HashTableGroup(controls + groupStart).MatchEmpty() != 0)
+	{
+		controls[index] = HashTableGroup::Empty;
+		return true;
+	}
+	controls[index] = HashTableGroup::Deleted;
+	return false;
+}
+
+template<typename Pair>
 class HashTableIterator
 {
 public:
-	HashTableIterator(BucketArray& buckets, usize valueCount, usize firstBucketIndex)
-		: Buckets(buckets)
-		, ValueCount(valueCount)
-		, InterBucketIndex(firstBucketIndex)
-		, IntraBucketIndex(0)
+	HashTableIterator(const uint8* controls, Pair* slots, usize capacity, usize index, const uint8* nextControls, Pair* nextSlots, usize nextCapacity)
+		: Controls(controls)
+		, Slots(slots)
+		, Capacity(capacity)
+		, Index(index)
+		, NextControls(nextControls)
+		, NextSlots(nextSlots)
+		, NextCapacity(nextCapacity)
 	{
+		SkipToNextGeneration();
 	}
 
 	Pair& operator*() const
 	{
-		return Buckets[InterBucketIndex][IntraBucketIndex];
+		return Slots[Index];
 	}
 
 	Pair* operator->() const
 	{
-		return &Buckets[InterBucketIndex][IntraBucketIndex];
+		return &Slots[Index];
 	}
 
 	HashTableIterator& operator++()
 	{
-		++IntraBucketIndex;
-		if (IntraBucketIndex == Buckets[InterBucketIndex].GetCount())
-		{
-			IntraBucketIndex = 0;
-			do
-			{
-				++InterBucketIndex;
-			} while (InterBucketIndex != Buckets.GetCount() && Buckets[InterBucketIndex].IsEmpty());
-		}
-		--ValueCount;
+		Index = FindNextFullSlot(Controls, Capacity, Index + 1);
+		SkipToNextGeneration();
 		return *this;
 	}
 
 	bool operator==(const HashTableIterator& rhs) const
 	{
-		return ValueCount == rhs.ValueCount && &Buckets == &rhs.Buckets;
+		return Index == rhs.Index && Slots == rhs.Slots;
 	}
 
 private:
-	BucketArray& Buckets;
-	usize ValueCount;
-	usize InterBucketIndex;
-	usize IntraBucketIndex;
-};
-
-template<typename K, typename InputK>
-concept IsValidHashTableKey = IsSame<RemoveCvType<InputK>, K>::Value || (IsSame<K, String>::Value && IsSame<RemoveCvType<InputK>, StringView>::Value);
-
-template<typename Pair, typename K, typename InputK>
-usize FindPairIndex(ArrayView<Pair> bucket, const InputK& key) requires IsValidHashTableKey<K, InputK>
-{
-	usize index = INDEX_NONE;
-	for (usize i = 0; i < bucket.GetCount(); ++i)
+	void SkipToNextGeneration()
 	{
-		const Pair& currentPair = bucket[i];
-		if (key == currentPair.Key)
+		if (Index == Capacity && NextSlots)
 		{
-			index = i;
-			break;
+			Controls = NextControls;
+			Slots = NextSlots;
+			Capacity = NextCapacity;
+			Index = FindNextFullSlot(Controls, Capacity, 0);
+
+			NextControls = nullptr;
+			NextSlots = nullptr;
+			NextCapacity = 0;
 		}
 	}
-	return index;
-}
+
+	const uint8* Controls;
+	Pair* Slots;
+	usize Capacity;
+	usize Index;
+
+	const uint8* NextControls;
+	Pair* NextSlots;
+	usize NextCapacity;
+};
+
+template<typename K, typename InputK>
+concept IsValidHashTableKey = IsSame<RemoveCvType<InputK>, K>::Value || (IsSame<K, String>::Value && IsSame<RemoveCvType<InputK>, StringView>::Value);
 
 template<typename T>
 concept IsEqualable = requires(T lhs, T rhs)
@@ -78,50 +229,82 @@ concept IsEqualable = requires(T lhs, T rhs)
 	lhs == rhs;
 };
 
-template<typename K, typename V> requires IsEqualable<K> && IsHashable<K, Hash<K>>
-class HashTable
+template<typename K, typename V>
+struct HashTablePair
+{
+	K Key;
+	V Value;
+};
+
+template<typename K, typename V>
+struct IsTriviallyRelocatable<HashTablePair<K, V>> : Constant<bool, IsTriviallyRelocatable<K>::Value && IsTriviallyRelocatable<V>::Value> {};
+
+template<typename K, typename V, typename AllocatorPolicy = DynamicAllocatorPolicy> requires IsEqualable<K> && IsHashable<K, Hash<K>>
+class HashTable : private AllocatorPolicy
 {
 public:
-	struct Pair
+	using Pair = HashTablePair<K, V>;
+
+	using AllocatorPolicy::GetAllocator;
+
+	HashTable()
+		: AllocatorPolicy()
+		, Current {}
+		, Previous {}
+		, MigrationIndex(0)
+		, ValueCount(0)
+		, GrowthLeft(0)
+		, IncrementalRehash(false)
 	{
-		K Key;
-		V Value;
-	};
+	}
 
-	using BucketArray = Array<Array<Pair>>;
+	explicit HashTable(Allocator* allocator)
+		: AllocatorPolicy(allocator)
+		, Current {}
+		, Previous {}
+		, MigrationIndex(0)
+		, ValueCount(0)
+		, GrowthLeft(0)
+		, IncrementalRehash(false)
+	{
+	}
 
-	explicit HashTable(usize bucketCount, Allocator* allocator = &GlobalAllocator::Get())
-		: ValueCount(0)
-		, Allocator(allocator)
+	explicit HashTable(usize capacity, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: AllocatorPolicy(allocator)
+		, Current {}
+		, Previous {}
+		, MigrationIndex(0)
+		, ValueCount(0)
+		, GrowthLeft(0)
+		, IncrementalRehash(false)
 	{
-		CHECK(bucketCount > 0);
-		new (&Buckets, LuftNewMarker {}) BucketArray(bucketCount, Allocator);
-		for (usize i = 0; i < bucketCount; ++i)
+		if (capacity > 0)
 		{
-			Buckets.Emplace(Allocator);
+			Current = AllocateGeneration(GetHashTableCapacityForCount(capacity));
+			GrowthLeft = GetHashTableMaxLoad(Current.Capacity);
 		}
 	}
 
 	~HashTable()
 	{
-		for (Array<Pair>& bucket : Buckets)
-		{
-			bucket.~Array();
-		}
-		Buckets.~Array();
+		FreeGeneration(Previous);
+		FreeGeneration(Current);
+		MigrationIndex = 0;
 		ValueCount = 0;
-		Allocator = nullptr;
+		GrowthLeft = 0;
+		IncrementalRehash = false;
 	}
 
 	HashTable(const HashTable& copy)
-		: ValueCount(copy.ValueCount)
-		, Allocator(copy.Allocator)
+		: AllocatorPolicy(copy)
+		, Current {}
+		, Previous {}
+		, MigrationIndex(0)
+		, ValueCount(0)
+		, GrowthLeft(0)
+		, IncrementalRehash(copy.IncrementalRehash)
 	{
-		new (&Buckets, LuftNewMarker {}) BucketArray(copy.Buckets.GetCount(), Allocator);
-		for (usize i = 0; i < copy.Buckets.GetCount(); ++i)
-		{
-			Buckets.Add(copy.Buckets[i]);
-		}
+		CopyFrom(copy);
 	}
 
 	HashTable& operator=(const HashTable& copy)
@@ -133,25 +316,27 @@ public:
 
 		this->~HashTable();
 
-		ValueCount = copy.ValueCount;
-		Allocator = copy.Allocator;
-
-		new (&Buckets, LuftNewMarker {}) BucketArray(copy.Buckets.GetCount(), Allocator);
-		for (usize i = 0; i < copy.Buckets.GetCount(); ++i)
-		{
-			Buckets.Add(copy.Buckets[i]);
-		}
+		AllocatorPolicy::operator=(copy);
+		IncrementalRehash = copy.IncrementalRehash;
+		CopyFrom(copy);
 
 		return *this;
 	}
 
 	HashTable(HashTable&& move) noexcept
-		: Buckets(Move(move.Buckets))
+		: AllocatorPolicy(Move(move))
+		, Current(move.Current)
+		, Previous(move.Previous)
+		, MigrationIndex(move.MigrationIndex)
 		, ValueCount(move.ValueCount)
-		, Allocator(move.Allocator)
+		, GrowthLeft(move.GrowthLeft)
+		, IncrementalRehash(move.IncrementalRehash)
 	{
+		move.Current = {};
+		move.Previous = {};
+		move.MigrationIndex = 0;
 		move.ValueCount = 0;
-		move.Allocator = nullptr;
+		move.GrowthLeft = 0;
 	}
 
 	HashTable& operator=(HashTable&& move) noexcept
@@ -163,12 +348,19 @@ public:
 
 		this->~HashTable();
 
-		Buckets = Move(move.Buckets);
+		Current = move.Current;
+		Previous = move.Previous;
+		MigrationIndex = move.MigrationIndex;
 		ValueCount = move.ValueCount;
-		Allocator = move.Allocator;
+		GrowthLeft = move.GrowthLeft;
+		IncrementalRehash = move.IncrementalRehash;
+		AllocatorPolicy::operator=(Move(move));
 
+		move.Current = {};
+		move.Previous = {};
+		move.MigrationIndex = 0;
 		move.ValueCount = 0;
-		move.Allocator = nullptr;
+		move.GrowthLeft = 0;
 
 		return *this;
 	}
@@ -190,175 +382,524 @@ public:
 		return ValueCount;
 	}
 
+	usize GetCapacity() const
+	{
+		return Current.Capacity;
+	}
+
 	bool IsEmpty() const
 	{
 		return ValueCount == 0;
 	}
 
+	bool IsRehashing() const
+	{
+		return Previous.Controls != nullptr;
+	}
+
+	void SetIncrementalRehash(bool incremental)
+	{
+		IncrementalRehash = incremental;
+		if (!incremental)
+		{
+			FinishMigration();
+		}
+	}
+
+	void Reserve(usize count)
+	{
+		FinishMigration();
+		if (count <= ValueCount + GrowthLeft)
+		{
+			return;
+		}
+		Rehash(GetHashTableCapacityForCount(Max(count, ValueCount)));
+	}
+
 	template<typename InputK>
 	bool Contains(const InputK& key) const requires IsValidHashTableKey<K, InputK>
 	{
-		const uint64 bucketIndex = Hash<InputK>{}(key) % Buckets.GetCount();
-		const Array<Pair>& bucket = Buckets[bucketIndex];
-
-		return FindPairIndex<Pair, K, InputK>(bucket, key) != INDEX_NONE;
+		return FindPair(key, Hash<InputK>{}(key)) != nullptr;
 	}
 
 	template<typename InputK>
 	V& Get(const InputK& key) requires IsValidHashTableKey<K, InputK>
 	{
-		const uint64 bucketIndex = Hash<InputK>{}(key) % Buckets.GetCount();
-		Array<Pair>& bucket = Buckets[bucketIndex];
-
-		const usize index = FindPairIndex<Pair, K, InputK>(bucket, key);
-		CHECK(index != INDEX_NONE);
-		return bucket[index].Value;
+		Pair* pair = FindPair(key, Hash<InputK>{}(key));
+		CHECK(pair);
+		return pair->Value;
 	}
 
 	template<typename InputK>
 	const V& Get(const InputK& key) const requires IsValidHashTableKey<K, InputK>
 	{
-		const uint64 bucketIndex = Hash<InputK>{}(key) % Buckets.GetCount();
-		const Array<Pair>& bucket = Buckets[bucketIndex];
+		const Pair* pair = FindPair(key, Hash<InputK>{}(key));
+		CHECK(pair);
+		return pair->Value;
+	}
+
+	template<typename InputK>
+	V* Find(const InputK& key) requires IsValidHashTableKey<K, InputK>
+	{
+		return FindWithHash(key, Hash<InputK>{}(key));
+	}
+
+	template<typename InputK>
+	const V* Find(const InputK& key) const requires IsValidHashTableKey<K, InputK>
+	{
+		return FindWithHash(key, Hash<InputK>{}(key));
+	}
+
+	// The hash has to be Hash<InputK>{}(key), computed once by the caller and reused across calls.
+	template<typename InputK>
+	V* FindWithHash(const InputK& key, uint64 hash) requires IsValidHashTableKey<K, InputK>
+	{
+		Pair* pair = FindPair(key, hash);
+		return pair ? &pair->Value : nullptr;
+	}
 
-		const usize index = FindPairIndex<Pair, K, InputK>(bucket, key);
-		CHECK(index != INDEX_NONE);
-		return bucket[index].Value;
+	template<typename InputK>
+	const V* FindWithHash(const InputK& key, uint64 hash) const requires IsValidHashTableKey<K, InputK>
+	{
+		const Pair* pair = FindPair(key, hash);
+		return pair ? &pair->Value : nullptr;
 	}
 
 	template<typename InputK>
 	V& GetOrAdd(const InputK& key) requires IsValidHashTableKey<K, InputK>
 	{
-		const uint64 bucketIndex = Hash<InputK>{}(key) % Buckets.GetCount();
-		Array<Pair>& bucket = Buckets[bucketIndex];
+		return GetOrAddWithHash(key, Hash<InputK>{}(key));
+	}
 
-		const usize index = FindPairIndex<Pair, K, InputK>(bucket, key);
-		if (index != INDEX_NONE)
+	V& GetOrAdd(K&& key)
+	{
+		const uint64 hash = Hash<K>{}(key);
+		return GetOrAddWithHash(Move(key), hash);
+	}
+
+	template<typename InputK>
+	V& GetOrAddWithHash(const InputK& key, uint64 hash) requires IsValidHashTableKey<K, InputK>
+	{
+		if (Pair* found = FindPair(key, hash))
 		{
-			return bucket[index].Value;
+			return found->Value;
 		}
 
+		Pair* pair = PrepareInsert(hash);
 		if constexpr (IsSame<RemoveCvType<InputK>, StringView>::Value)
 		{
-			bucket.Add(Pair { String(key, Allocator), {} });
+			new (pair, LuftNewMarker {}) Pair { String(key, GetAllocator()), {} };
 		}
 		else
 		{
-			bucket.Add(Pair { key, {} });
+			new (pair, LuftNewMarker {}) Pair { key, {} };
 		}
-		++ValueCount;
-
-		return bucket[bucket.GetCount() - 1].Value;
+		return pair->Value;
 	}
 
-	V& GetOrAdd(K&& key)
+	V& GetOrAddWithHash(K&& key, uint64 hash)
 	{
-		const uint64 bucketIndex = Hash<K>{}(key) % Buckets.GetCount();
-		Array<Pair>& bucket = Buckets[bucketIndex];
-
-		const usize index = FindPairIndex<Pair, K, K>(bucket, key);
-		if (index != INDEX_NONE)
+		if (Pair* found = FindPair(key, hash))
 		{
-			return bucket[index].Value;
+			return found->Value;
 		}
 
-		bucket.Add(Pair { Move(key), {} });
-		++ValueCount;
+		Pair* pair = PrepareInsert(hash);
+		new (pair, LuftNewMarker {}) Pair { Move(key), {} };
+		return pair->Value;
+	}
 
-		return bucket[bucket.GetCount() - 1].Value;
+	// Writes a pointer to each key's value, or null for missing keys, into outValues and returns how many were found.
+	usize LookupBatch(ArrayView<K> keys, V** outValues)
+	{
+		return ResolveBatch(keys, outValues);
 	}
 
-	bool Add(const K& key, const V& value)
+	usize LookupBatch(ArrayView<K> keys, const V** outValues) const
 	{
-		const uint64 bucketIndex = Hash<K>{}(key) % Buckets.GetCount();
-		Array<Pair>& bucket = Buckets[bucketIndex];
+		return ResolveBatch(keys, outValues);
+	}
 
-		const usize index = FindPairIndex<Pair, K, K>(Buckets[bucketIndex], key);
-		if (index != INDEX_NONE)
+	template<typename InputK>
+	usize LookupBatch(ArrayView<InputK> keys, V** outValues) requires IsValidHashTableKey<K, InputK>
+	{
+		return ResolveBatch(keys, outValues);
+	}
+
+	template<typename InputK>
+	usize LookupBatch(ArrayView<InputK> keys, const V** outValues) const requires IsValidHashTableKey<K, InputK>
+	{
+		return ResolveBatch(keys, outValues);
+	}
+
+	bool Add(const K& key, const V& value)
+	{
+		const uint64 hash = Hash<K>{}(key);
+		if (Pair* found = FindPair(key, hash))
 		{
-			bucket[index] = Pair { key, value };
+			*found = Pair { key, value };
 			return false;
 		}
 
-		bucket.Add(Pair { key, value });
-		++ValueCount;
+		new (PrepareInsert(hash), LuftNewMarker {}) Pair { key, value };
 		return true;
 	}
 
 	bool Add(K&& key, V&& value)
 	{
-		const uint64 bucketIndex = Hash<K>{}(key) % Buckets.GetCount();
-		Array<Pair>& bucket = Buckets[bucketIndex];
-
-		const usize index = FindPairIndex<Pair, K, K>(Buckets[bucketIndex], key);
-		if (index != INDEX_NONE)
+		const uint64 hash = Hash<K>{}(key);
+		if (Pair* found = FindPair(key, hash))
 		{
-			bucket[index] = Pair { Move(key), Move(value) };
+			*found = Pair { Move(key), Move(value) };
 			return false;
 		}
 
-		bucket.Add(Pair { Move(key), Move(value) });
-		++ValueCount;
+		new (PrepareInsert(hash), LuftNewMarker {}) Pair { Move(key), Move(value) };
 		return true;
 	}
 
 	template<typename InputK>
 	void Remove(const InputK& key) requires IsValidHashTableKey<K, InputK>
 	{
-		const uint64 bucketIndex = Hash<InputK>{}(key) % Buckets.GetCount();
+		const uint64 hash = Hash<InputK>{}(key);
 
-		const usize index = FindPairIndex<Pair, K, InputK>(Buckets[bucketIndex], key);
-		CHECK(index != INDEX_NONE);
+		usize index = FindIndex(Current, key, hash);
+		if (index != INDEX_NONE)
+		{
+			Current.Slots[index].~Pair();
+			if (EraseHashTableSlot(Current.Controls, index))
+			{
+				++GrowthLeft;
+			}
+		}
+		else
+		{
+			index = FindIndex(Previous, key, hash);
+			CHECK(index != INDEX_NONE);
 
-		Buckets[bucketIndex].Remove(index);
+			// Nothing is inserted into the previous generation anymore, so it can always take a tombstone.
+			Previous.Slots[index].~Pair();
+			Previous.Controls[index] = HashTableGroup::Deleted;
+		}
 		--ValueCount;
+
+		MigrateStep();
 	}
 
 	void Clear()
 	{
-		ValueCount = 0;
-		for (Array<Pair>& bucket : Buckets)
+		FreeGeneration(Previous);
+		MigrationIndex = 0;
+
+		if (Current.Controls)
 		{
-			bucket.Clear();
+			DestroyValues(Current);
+			Platform::MemorySet(Current.Controls, HashTableGroup::Empty, Current.Capacity);
 		}
+		ValueCount = 0;
+		GrowthLeft = GetHashTableMaxLoad(Current.Capacity);
 	}
 
-	HashTableIterator<BucketArray, Pair> begin()
+	HashTableIterator<Pair> begin()
 	{
-		return HashTableIterator<BucketArray, Pair>(Buckets, ValueCount, FindFirstUsedBucket());
+		return HashTableIterator<Pair>(Current.Controls, Current.Slots, Current.Capacity, FindNextFullSlot(Current.Controls, Current.Capacity, 0), Previous.Controls, Previous.Slots, Previous.Capacity);
 	}
 
-	HashTableIterator<BucketArray, Pair> end()
+	HashTableIterator<Pair> end()
 	{
-		return HashTableIterator<BucketArray, Pair>(Buckets, 0, 0);
+		const Generation& last = Previous.Controls ? Previous : Current;
+		return HashTableIterator<Pair>(last.Controls, last.Slots, last.Capacity, last.Capacity, nullptr, nullptr, 0);
 	}
 
-	HashTableIterator<const BucketArray, const Pair> begin() const
+	HashTableIterator<const Pair> begin() const
 	{
-		return HashTableIterator<const BucketArray, const Pair>(Buckets, ValueCount, FindFirstUsedBucket());
+		return HashTableIterator<const Pair>(Current.Controls, Current.Slots, Current.Capacity, FindNextFullSlot(Current.Controls, Current.Capacity, 0), Previous.Controls, Previous.Slots, Previous.Capacity);
 	}
 
-	HashTableIterator<const BucketArray, const Pair> end() const
+	HashTableIterator<const Pair> end() const
 	{
-		return HashTableIterator<const BucketArray, const Pair>(Buckets, 0, 0);
+		const Generation& last = Previous.Controls ? Previous : Current;
+		return HashTableIterator<const Pair>(last.Controls, last.Slots, last.Capacity, last.Capacity, nullptr, nullptr, 0);
 	}
 
 private:
-	usize FindFirstUsedBucket() const
+	struct Generation
+	{
+		uint8* Controls;
+		Pair* Slots;
+		usize Capacity;
+	};
+
+	static constexpr usize Alignment = alignof(Pair) > HashTableGroup::Width ? alignof(Pair) : HashTableGroup::Width;
+
+	static constexpr usize MigrationGroupsPerStep = 2;
+
+	static usize GetSlotsOffset(usize capacity)
+	{
+		return AlignUp(capacity, alignof(Pair));
+	}
+
+	static usize GetAllocationSize(usize capacity)
 	{
-		usize index = INDEX_NONE;
-		for (usize i = 0; i < Buckets.GetCount(); ++i)
+		return GetSlotsOffset(capacity) + capacity * sizeof(Pair);
+	}
+
+	template<typename InputK>
+	static usize FindIndex(const Generation& generation, const InputK& key, uint64 hash)
+	{
+		return FindHashTableIndex(generation.Controls, generation.Capacity, hash, [&generation, &key](usize index) { return key == generation.Slots[index].Key; });
+	}
+
+	static usize FindInsertIndex(const Generation& generation, uint64 hash)
+	{
+		return FindHashTableInsertIndex(generation.Controls, generation.Capacity, hash);
+	}
+
+	static void DestroyValues(const Generation& generation)
+	{
+		if constexpr (!IsTriviallyDestructible<Pair>::Value)
+		{
+			for (usize i = FindNextFullSlot(generation.Controls, generation.Capacity, 0); i < generation.Capacity; i = FindNextFullSlot(generation.Controls, generation.Capacity, i + 1))
+			{
+				generation.Slots[i].~Pair();
+			}
+		}
+	}
+
+	template<typename InputK>
+	Pair* FindPair(const InputK& key, uint64 hash) const
+	{
+		usize index = FindIndex(Current, key, hash);
+		if (index != INDEX_NONE)
+		{
+			return &Current.Slots[index];
+		}
+
+		if (Previous.Controls)
+		{
+			index = FindIndex(Previous, key, hash);
+			if (index != INDEX_NONE)
+			{
+				return &Previous.Slots[index];
+			}
+		}
+		return nullptr;
+	}
+
+	template<typename InputK, typename ValuePointer>
+	usize ResolveBatch(ArrayView<InputK> keys, ValuePointer* outValues) const
+	{
+		static constexpr usize batchSize = 16;
+
+		usize foundCount = 0;
+		for (usize batchStart = 0; batchStart < keys.GetCount(); batchStart += batchSize)
 		{
-			if (!Buckets[i].IsEmpty())
+			const usize batchCount = Min(batchSize, keys.GetCount() - batchStart);
+
+			uint64 hashes[batchSize];
+			for (usize i = 0; i < batchCount; ++i)
 			{
-				index = i;
-				break;
+				hashes[i] = Hash<InputK>{}(keys[batchStart + i]);
+				Prefetch(Current, hashes[i]);
 			}
+
+			for (usize i = 0; i < batchCount; ++i)
+			{
+				Pair* pair = FindPair(keys[batchStart + i], hashes[i]);
+				outValues[batchStart + i] = pair ? &pair->Value : nullptr;
+				foundCount += pair != nullptr;
+			}
+		}
+		return foundCount;
+	}
+
+	static void Prefetch(const Generation& generation, uint64 hash)
+	{
+		if (generation.Capacity == 0)
+		{
+			return;
 		}
-		return index;
+
+		const usize groupMask = generation.Capacity / HashTableGroup::Width - 1;
+		const usize groupStart = (GetHashTableFirstGroup(hash) & groupMask) * HashTableGroup::Width;
+		_mm_prefetch(reinterpret_cast<const char*>(generation.Controls + groupStart), _MM_HINT_T0);
+		_mm_prefetch(reinterpret_cast<const char*>(generation.Slots + groupStart), _MM_HINT_T0);
+	}
+
+	Generation AllocateGeneration(usize capacity)
+	{
+		CHECK(IsPowerOfTwo(capacity) && capacity >= HashTableGroup::Width);
+
+		uint8* memory = static_cast<uint8*>(AllocatorPolicy::Allocate(GetAllocationSize(capacity), Alignment));
+		Platform::MemorySet(memory, HashTableGroup::Empty, capacity);
+
+		return Generation { memory, reinterpret_cast<Pair*>(memory + GetSlotsOffset(capacity)), capacity };
 	}
 
-	BucketArray Buckets;
+	void FreeGeneration(Generation& generation)
+	{
+		if (generation.Controls)
+		{
+			DestroyValues(generation);
+			AllocatorPolicy::Deallocate(generation.Controls, GetAllocationSize(generation.Capacity), Alignment);
+		}
+		generation = {};
+	}
+
+	void CopyFrom(const HashTable& copy)
+	{
+		if (copy.Current.Capacity == 0)
+		{
+			return;
+		}
+
+		if (copy.Previous.Controls)
+		{
+			Current = AllocateGeneration(GetHashTableCapacityForCount(copy.ValueCount));
+			GrowthLeft = GetHashTableMaxLoad(Current.Capacity);
+			for (const Pair& pair : copy)
+			{
+				const uint64 hash = Hash<K>{}(pair.Key);
+				const usize index = FindInsertIndex(Current, hash);
+				Current.Controls[index] = GetHashTableTag(hash);
+				new (&Current.Slots[index], LuftNewMarker {}) Pair(pair);
+				--GrowthLeft;
+			}
+			ValueCount = copy.ValueCount;
+			return;
+		}
+
+		Current = AllocateGeneration(copy.Current.Capacity);
+		Platform::MemoryCopy(Current.Controls, copy.Current.Controls, Current.Capacity);
+		for (usize i = FindNextFullSlot(Current.Controls, Current.Capacity, 0); i < Current.Capacity; i = FindNextFullSlot(Current.Controls, Current.Capacity, i + 1))
+		{
+			new (&Current.Slots[i], LuftNewMarker {}) Pair(copy.Current.Slots[i]);
+		}
+		ValueCount = copy.ValueCount;
+		GrowthLeft = copy.GrowthLeft;
+	}
+
+	Pair* PrepareInsert(uint64 hash)
+	{
+		MigrateStep();
+
+		usize index = Current.Capacity > 0 ? FindInsertIndex(Current, hash) : INDEX_NONE;
+		if (index == INDEX_NONE || (GrowthLeft == 0 && Current.Controls[index] == HashTableGroup::Empty))
+		{
+			Grow();
+			index = FindInsertIndex(Current, hash);
+		}
+
+		if (Current.Controls[index] == HashTableGroup::Empty)
+		{
+			--GrowthLeft;
+		}
+		Current.Controls[index] = GetHashTableTag(hash);
+		++ValueCount;
+
+		return &Current.Slots[index];
+	}
+
+	void Grow()
+	{
+		FinishMigration();
+
+		const usize newCapacity = GetHashTableRehashCapacity(ValueCount, Current.Capacity);
+		const bool grow = newCapacity != Current.Capacity;
+
+		if (IncrementalRehash && grow && ValueCount > 0)
+		{
+			Previous = Current;
+			MigrationIndex = 0;
+			Current = AllocateGeneration(newCapacity);
+			GrowthLeft = GetHashTableMaxLoad(newCapacity);
+		}
+		else
+		{
+			Rehash(newCapacity);
+		}
+	}
+
+	void Rehash(usize newCapacity)
+	{
+		Generation old = Current;
+
+		Current = AllocateGeneration(newCapacity);
+		GrowthLeft = GetHashTableMaxLoad(newCapacity);
+		for (usize i = FindNextFullSlot(old.Controls, old.Capacity, 0); i < old.Capacity; i = FindNextFullSlot(old.Controls, old.Capacity, i + 1))
+		{
+			MoveToCurrent(old, i);
+		}
+
+		if (old.Controls)
+		{
+			AllocatorPolicy::Deallocate(old.Controls, GetAllocationSize(old.Capacity), Alignment);
+		}
+	}
+
+	void MoveToCurrent(Generation& from, usize fromIndex)
+	{
+		Pair& pair = from.Slots[fromIndex];
+		const uint64 hash = Hash<K>{}(pair.Key);
+		const usize index = FindInsertIndex(Current, hash);
+
+		CHECK(Current.Controls[index] != HashTableGroup::Empty || GrowthLeft > 0);
+		if (Current.Controls[index] == HashTableGroup::Empty)
+		{
+			--GrowthLeft;
+		}
+		Current.Controls[index] = GetHashTableTag(hash);
+		from.Controls[fromIndex] = HashTableGroup::Deleted;
+
+		if constexpr (IsTriviallyRelocatable<Pair>::Value)
+		{
+			Platform::MemoryCopy(&Current.Slots[index], &pair, sizeof(Pair));
+		}
+		else
+		{
+			new (&Current.Slots[index], LuftNewMarker {}) Pair(MoveIfPossible(pair));
+			pair.~Pair();
+		}
+	}
+
+	void MigrateStep()
+	{
+		if (!Previous.Controls)
+		{
+			return;
+		}
+
+		const usize migrationEnd = Min(MigrationIndex + MigrationGroupsPerStep * HashTableGroup::Width, Previous.Capacity);
+		for (usize i = FindNextFullSlot(Previous.Controls, migrationEnd, MigrationIndex); i < migrationEnd; i = FindNextFullSlot(Previous.Controls, migrationEnd, i + 1))
+		{
+			MoveToCurrent(Previous, i);
+		}
+		MigrationIndex = migrationEnd;
+
+		if (MigrationIndex == Previous.Capacity)
+		{
+			FreeGeneration(Previous);
+			MigrationIndex = 0;
+		}
+	}
+
+	void FinishMigration()
+	{
+		while (Previous.Controls)
+		{
+			MigrateStep();
+		}
+	}
+
+	Generation Current;
+	Generation Previous;
+	usize MigrationIndex;
+
 	usize ValueCount;
-	Allocator* Allocator;
+	usize GrowthLeft;
+
+	bool IncrementalRehash;
 };
+
+template<typename K, typename V, typename AllocatorPolicy>
+struct IsTriviallyRelocatable<HashTable<K, V, AllocatorPolicy>> : TrueConstant {};
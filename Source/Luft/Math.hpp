@@ -3,6 +3,10 @@
 #include "Base.hpp"
 #include "Error.hpp"
 
+#if PLATFORM_WINDOWS
+#include <intrin.h>
+#endif
+
 inline constexpr float32 Pi = 3.14159265358979323846f;
 inline constexpr float32 DegreesToRadians = Pi / 180.0f;
 inline constexpr float32 RadiansToDegrees = 180.0f / Pi;
@@ -60,6 +64,42 @@ inline uint64 NextMultipleOf(uint64 value, uint64 multiple)
 	return (((value - 1) / multiple) + 1) * multiple;
 }
 
+inline bool IsPowerOfTwo(uint64 value)
+{
+	return value != 0 && (value & (value - 1)) == 0;
+}
+
+inline uint64 AlignUp(uint64 value, uint64 alignment)
+{
+	CHECK(IsPowerOfTwo(alignment));
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+inline uint32 FloorLog2(uint64 value)
+{
+	CHECK(value != 0);
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return index;
+}
+
+inline uint32 CountTrailingZeros(uint64 value)
+{
+	CHECK(value != 0);
+#if defined(__AVX2__)
+	return static_cast<uint32>(_tzcnt_u64(value));
+#else
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return index;
+#endif
+}
+
+inline uint32 CountSetBits(uint64 value)
+{
+	return static_cast<uint32>(__popcnt64(value));
+}
+
 inline bool IsPointInRectangle(float32 x, float32 y, float32 left, float32 right, float32 top, float32 bottom)
 {
 	return x >= left && x <= right && y >= top && y <= bottom;
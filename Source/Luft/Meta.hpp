@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Base.hpp"
+
 template<typename Type, Type V>
 struct Constant
 {
@@ -39,6 +41,18 @@ struct IsTriviallyCopyable : Constant<bool, __is_trivially_copyable(T)> {};
 template<typename T>
 struct IsTriviallyDestructible : Constant<bool, __is_trivially_destructible(T)> {};
 
+// Relocating moves an object to a new address with a memcpy and then forgets the old bytes without running the destructor.
+// Types that do not point into themselves can opt in by specializing this.
+template<typename T>
+struct IsTriviallyRelocatable : IsTriviallyCopyable<T> {};
+
+template<usize Index, typename T, typename... Ts>
+struct TypeAt { using Type = typename TypeAt<Index - 1, Ts...>::Type; };
+template<typename T, typename... Ts>
+struct TypeAt<0, T, Ts...> { using Type = T; };
+template<usize Index, typename... Ts>
+using TypeAtType = typename TypeAt<Index, Ts...>::Type;
+
 template<typename T>
 struct RemoveCv { using Type = T; };
 template<typename T>
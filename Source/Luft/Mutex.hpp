@@ -0,0 +1,37 @@
+#pragma once
+
+#include "NoCopy.hpp"
+
+class Mutex : public NoCopy
+{
+public:
+	constexpr Mutex()
+		: Native(nullptr)
+	{
+	}
+
+	void Lock();
+	void Unlock();
+	bool TryLock();
+
+private:
+	void* Native;
+};
+
+class MutexLock : public NoCopy
+{
+public:
+	explicit MutexLock(Mutex* mutex)
+		: Locked(mutex)
+	{
+		Locked->Lock();
+	}
+
+	~MutexLock()
+	{
+		Locked->Unlock();
+	}
+
+private:
+	Mutex* Locked;
+};
@@ -0,0 +1,177 @@
+#include "OffsetAllocator.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+
+OffsetAllocator::OffsetAllocator(usize capacity, usize minBlockSize, Allocator* allocator)
+	: Units(allocator)
+	, FreeLists(allocator)
+	, FreeListBitmap(0)
+	, MinBlockSizeLog2(0)
+	, FreeSize(0)
+{
+	CHECK(IsPowerOfTwo(minBlockSize));
+	CHECK(capacity >= minBlockSize);
+
+	MinBlockSizeLog2 = FloorLog2(minBlockSize);
+
+	const usize unitCount = capacity >> MinBlockSizeLog2;
+	CHECK(unitCount < InvalidUnit);
+
+	Units.Reserve(unitCount);
+	Units.AddUninitialized(unitCount);
+	for (Unit& unit : Units)
+	{
+		unit = { InvalidUnit, InvalidUnit, 0, UnitState::Interior };
+	}
+
+	const usize orderCount = FloorLog2(unitCount) + 1;
+	FreeLists.Reserve(orderCount);
+	for (usize i = 0; i < orderCount; ++i)
+	{
+		FreeLists.Add(InvalidUnit);
+	}
+
+	usize unit = 0;
+	usize remaining = unitCount;
+	while (remaining)
+	{
+		const uint32 order = FloorLog2(remaining);
+		InsertFreeBlock(static_cast<uint32>(unit), order);
+		unit += 1ull << order;
+		remaining -= 1ull << order;
+	}
+}
+
+usize OffsetAllocator::Allocate(usize size, usize alignment)
+{
+	CHECK(size > 0);
+	CHECK(IsPowerOfTwo(alignment));
+
+	const usize minBlockSize = 1ull << MinBlockSizeLog2;
+	const usize unitCount = (Max(size, alignment) + minBlockSize - 1) >> MinBlockSizeLog2;
+	const uint32 order = unitCount > 1 ? FloorLog2(unitCount - 1) + 1 : 0;
+	if (order >= FreeLists.GetCount())
+	{
+		return InvalidOffset;
+	}
+
+	const uint64 available = FreeListBitmap & (~0ull << order);
+	if (available == 0)
+	{
+		return InvalidOffset;
+	}
+
+	uint32 currentOrder = CountTrailingZeros(available);
+	const uint32 unit = FreeLists[currentOrder];
+	RemoveFreeBlock(unit, currentOrder);
+
+	while (currentOrder > order)
+	{
+		--currentOrder;
+		InsertFreeBlock(unit + (1u << currentOrder), currentOrder);
+	}
+
+	Units[unit].Order = static_cast<uint8>(order);
+	Units[unit].State = UnitState::Allocated;
+
+	return static_cast<usize>(unit) << MinBlockSizeLog2;
+}
+
+void OffsetAllocator::Deallocate(usize offset)
+{
+	CHECK(offset != InvalidOffset);
+	CHECK((offset & ((1ull << MinBlockSizeLog2) - 1)) == 0);
+
+	uint32 unit = static_cast<uint32>(offset >> MinBlockSizeLog2);
+	CHECK(Units[unit].State == UnitState::Allocated);
+
+	uint32 order = Units[unit].Order;
+	Units[unit].State = UnitState::Interior;
+
+	while (order + 1 < FreeLists.GetCount())
+	{
+		const uint32 buddy = unit ^ (1u << order);
+		if (buddy + (1ull << order) > Units.GetCount())
+		{
+			break;
+		}
+
+		const Unit& buddyUnit = Units[buddy];
+		if (buddyUnit.State != UnitState::Free || buddyUnit.Order != order)
+		{
+			break;
+		}
+
+		RemoveFreeBlock(buddy, order);
+
+		unit = Min(unit, buddy);
+		++order;
+	}
+
+	InsertFreeBlock(unit, order);
+}
+
+usize OffsetAllocator::GetAllocationSize(usize offset) const
+{
+	const usize unit = offset >> MinBlockSizeLog2;
+	CHECK(Units[unit].State == UnitState::Allocated);
+	return 1ull << (Units[unit].Order + MinBlockSizeLog2);
+}
+
+usize OffsetAllocator::GetLargestFreeRegion() const
+{
+	if (FreeListBitmap == 0)
+	{
+		return 0;
+	}
+	return 1ull << (FloorLog2(FreeListBitmap) + MinBlockSizeLog2);
+}
+
+void OffsetAllocator::InsertFreeBlock(uint32 unit, uint32 order)
+{
+	const uint32 head = FreeLists[order];
+
+	Unit& freeUnit = Units[unit];
+	freeUnit.NextFree = head;
+	freeUnit.PreviousFree = InvalidUnit;
+	freeUnit.Order = static_cast<uint8>(order);
+	freeUnit.State = UnitState::Free;
+
+	if (head != InvalidUnit)
+	{
+		Units[head].PreviousFree = unit;
+	}
+	FreeLists[order] = unit;
+	FreeListBitmap |= 1ull << order;
+
+	FreeSize += 1ull << (order + MinBlockSizeLog2);
+}
+
+void OffsetAllocator::RemoveFreeBlock(uint32 unit, uint32 order)
+{
+	Unit& freeUnit = Units[unit];
+	CHECK(freeUnit.State == UnitState::Free && freeUnit.Order == order);
+
+	if (freeUnit.PreviousFree != InvalidUnit)
+	{
+		Units[freeUnit.PreviousFree].NextFree = freeUnit.NextFree;
+	}
+	else
+	{
+		FreeLists[order] = freeUnit.NextFree;
+		if (freeUnit.NextFree == InvalidUnit)
+		{
+			FreeListBitmap &= ~(1ull << order);
+		}
+	}
+	if (freeUnit.NextFree != InvalidUnit)
+	{
+		Units[freeUnit.NextFree].PreviousFree = freeUnit.PreviousFree;
+	}
+
+	freeUnit.NextFree = InvalidUnit;
+	freeUnit.PreviousFree = InvalidUnit;
+	freeUnit.State = UnitState::Interior;
+
+	FreeSize -= 1ull << (order + MinBlockSizeLog2);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Base.hpp"
+#include "NoCopy.hpp"
+
+class OffsetAllocator : public NoCopy
+{
+public:
+	static constexpr usize InvalidOffset = ~static_cast<usize>(0);
+
+	explicit OffsetAllocator(usize capacity, usize minBlockSize = 256, Allocator* allocator = &GlobalAllocator::Get());
+
+	// Alignment is relative to the start of the managed range.
+	usize Allocate(usize size, usize alignment = 1);
+	void Deallocate(usize offset);
+
+	usize GetAllocationSize(usize offset) const;
+	usize GetLargestFreeRegion() const;
+
+	usize GetFreeSize() const
+	{
+		return FreeSize;
+	}
+
+	usize GetCapacity() const
+	{
+		return static_cast<usize>(Units.GetCount()) << MinBlockSizeLog2;
+	}
+
+private:
+	static constexpr uint32 InvalidUnit = ~0u;
+
+	enum class UnitState : uint8
+	{
+		Interior,
+		Free,
+		Allocated,
+	};
+
+	struct Unit
+	{
+		uint32 NextFree;
+		uint32 PreviousFree;
+		uint8 Order;
+		UnitState State;
+	};
+
+	void InsertFreeBlock(uint32 unit, uint32 order);
+	void RemoveFreeBlock(uint32 unit, uint32 order);
+
+	Array<Unit> Units;
+	Array<uint32> FreeLists;
+	uint64 FreeListBitmap;
+
+	usize MinBlockSizeLog2;
+	usize FreeSize;
+};
@@ -16,13 +16,26 @@ void MemoryCopy(void* destination, const void* source, usize size);
 void MemoryMove(void* destination, const void* source, usize size);
 
 void* Allocate(usize size);
+void* Reallocate(void* ptr, usize size);
+bool TryReallocateInPlace(void* ptr, usize size);
 void Deallocate(void* ptr);
 
+void* AllocateAligned(usize size, usize alignment);
+void DeallocateAligned(void* ptr);
+
+usize GetPageSize();
+void* ReserveMemory(usize size);
+void CommitMemory(void* ptr, usize size);
+void DecommitMemory(void* ptr, usize size);
+void ReleaseMemory(void* ptr);
+
 bool StringCompare(const char* a, usize aLength, const char* b, usize bLength);
 usize StringLength(const char* string0);
 
 void StringPrint(const char* format0, char* buffer, usize bufferSize, ...);
 
+usize CaptureCallStack(void** frames, usize frameCount, usize skipCount);
+
 void FatalError(const char* errorMessage0);
 
 }
@@ -0,0 +1,178 @@
+#include "RingAllocator.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+
+RingAllocator::RingAllocator(usize capacity, Allocator* parent)
+	: Buffer(nullptr)
+	, Capacity(capacity)
+	, Head(0)
+	, Tail(0)
+	, Used(0)
+	, Frames {}
+	, FirstFrame(0)
+	, FrameCount(0)
+	, Parent(parent)
+{
+	CHECK(Capacity > 0);
+	CHECK(Parent);
+
+	Buffer = static_cast<uint8*>(Parent->Allocate(Capacity));
+}
+
+RingAllocator::~RingAllocator()
+{
+	Parent->Deallocate(Buffer, Capacity);
+
+	Buffer = nullptr;
+	Capacity = 0;
+	Head = 0;
+	Tail = 0;
+	Used = 0;
+	FrameCount = 0;
+}
+
+void* RingAllocator::Allocate(usize size, usize alignment)
+{
+	CHECK(FrameCount > 0);
+
+	if (Used == 0)
+	{
+		Head = 0;
+		Tail = 0;
+		for (usize i = 0; i < FrameCount; ++i)
+		{
+			GetFrame(i).Start = 0;
+		}
+	}
+
+	usize offset = GetAlignedOffset(Head, alignment);
+	if (Used != 0 && Head <= Tail)
+	{
+		VERIFY(Head != Tail && offset + size <= Tail, "Ring allocator is out of space!");
+	}
+	else if (offset + size > Capacity)
+	{
+		offset = GetAlignedOffset(0, alignment);
+		VERIFY(offset + size <= (Used == 0 ? Capacity : Tail), "Ring allocator is out of space!");
+	}
+
+	const usize newHead = offset + size;
+	const usize consumed = newHead >= Head ? newHead - Head : Capacity - Head + newHead;
+
+	Head = newHead;
+	Used += consumed;
+	GetFrame(FrameCount - 1).Size += consumed;
+
+	return Buffer + offset;
+}
+
+void RingAllocator::Deallocate(void* ptr, usize size, usize alignment)
+{
+	(void)alignment;
+
+	if (ptr == nullptr || FrameCount == 0)
+	{
+		return;
+	}
+
+	const uint8* bytes = static_cast<uint8*>(ptr);
+	if (bytes < Buffer || bytes + size != Buffer + Head)
+	{
+		return;
+	}
+
+	Frame& current = GetFrame(FrameCount - 1);
+	const usize offset = static_cast<usize>(bytes - Buffer);
+	if (Head - offset <= current.Size)
+	{
+		current.Size -= Head - offset;
+		Used -= Head - offset;
+		Head = offset;
+	}
+}
+
+bool RingAllocator::TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	(void)alignment;
+
+	CHECK(ptr);
+	CHECK(newSize >= oldSize);
+
+	if (FrameCount == 0)
+	{
+		return false;
+	}
+
+	const uint8* bytes = static_cast<uint8*>(ptr);
+	if (bytes < Buffer || bytes + oldSize != Buffer + Head)
+	{
+		return false;
+	}
+
+	// A block from an earlier frame is reclaimed with that frame, so growing it into the current one would leave
+	// the caller holding memory that is freed underneath it.
+	Frame& current = GetFrame(FrameCount - 1);
+	const usize offset = static_cast<usize>(bytes - Buffer);
+	if (Head - offset > current.Size)
+	{
+		return false;
+	}
+
+	const usize growth = newSize - oldSize;
+	if (Head + growth > GetFreeEnd())
+	{
+		return false;
+	}
+
+	Head += growth;
+	Used += growth;
+	current.Size += growth;
+	return true;
+}
+
+void RingAllocator::BeginFrame(uint64 frameIndex)
+{
+	if (FrameCount > 0)
+	{
+		CHECK(frameIndex > GetFrame(FrameCount - 1).Index);
+	}
+	VERIFY(FrameCount < MaxFramesInFlight, "Too many frames in flight for the ring allocator!");
+
+	++FrameCount;
+	GetFrame(FrameCount - 1) = Frame { frameIndex, Head, 0 };
+}
+
+void RingAllocator::EndFrame(uint64 frameIndex)
+{
+	while (FrameCount > 0 && GetFrame(0).Index <= frameIndex)
+	{
+		Used -= GetFrame(0).Size;
+		FirstFrame = (FirstFrame + 1) % MaxFramesInFlight;
+		--FrameCount;
+	}
+
+	if (FrameCount == 0)
+	{
+		CHECK(Used == 0);
+		Tail = Head;
+	}
+	else
+	{
+		Tail = GetFrame(0).Start;
+	}
+}
+
+usize RingAllocator::GetAlignedOffset(usize offset, usize alignment) const
+{
+	const uint64 address = reinterpret_cast<uint64>(Buffer) + offset;
+	return offset + (AlignUp(address, Max(alignment, DefaultAlignment)) - address);
+}
+
+usize RingAllocator::GetFreeEnd() const
+{
+	if (Used == 0 || Head > Tail)
+	{
+		return Capacity;
+	}
+	return Head == Tail ? Head : Tail;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Base.hpp"
+
+class RingAllocator final : public Allocator
+{
+public:
+	static constexpr usize MaxFramesInFlight = 8;
+
+	explicit RingAllocator(usize capacity, Allocator* parent = &GlobalAllocator::Get());
+	~RingAllocator() override;
+
+	void* Allocate(usize size, usize alignment = DefaultAlignment) override;
+	void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) override;
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+
+	void BeginFrame(uint64 frameIndex);
+	void EndFrame(uint64 frameIndex);
+
+	usize GetUsed() const
+	{
+		return Used;
+	}
+
+	usize GetCapacity() const
+	{
+		return Capacity;
+	}
+
+private:
+	struct Frame
+	{
+		uint64 Index;
+		usize Start;
+		usize Size;
+	};
+
+	Frame& GetFrame(usize queueIndex)
+	{
+		return Frames[(FirstFrame + queueIndex) % MaxFramesInFlight];
+	}
+
+	usize GetAlignedOffset(usize offset, usize alignment) const;
+	usize GetFreeEnd() const;
+
+	uint8* Buffer;
+	usize Capacity;
+	usize Head;
+	usize Tail;
+	usize Used;
+
+	Frame Frames[MaxFramesInFlight];
+	usize FirstFrame;
+	usize FrameCount;
+
+	Allocator* Parent;
+};
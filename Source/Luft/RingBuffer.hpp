@@ -0,0 +1,373 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+#include "Meta.hpp"
+#include "NoCopy.hpp"
+#include "PlatformCore.hpp"
+
+template<typename T, typename AllocatorPolicy = DynamicAllocatorPolicy>
+class RingBuffer : public NoCopy, private AllocatorPolicy
+{
+public:
+	using AllocatorPolicy::GetAllocator;
+
+	RingBuffer()
+		: AllocatorPolicy()
+		, Elements(nullptr)
+		, Head(0)
+		, Count(0)
+		, Capacity(0)
+	{
+	}
+
+	explicit RingBuffer(Allocator* allocator)
+		: AllocatorPolicy(allocator)
+		, Elements(nullptr)
+		, Head(0)
+		, Count(0)
+		, Capacity(0)
+	{
+	}
+
+	explicit RingBuffer(usize capacity, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: RingBuffer(allocator)
+	{
+		Reserve(capacity);
+	}
+
+	~RingBuffer()
+	{
+		if (AllocatorPolicy::HasAllocator())
+		{
+			Clear();
+			AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
+		}
+		else
+		{
+			CHECK(Elements == nullptr);
+		}
+
+		Elements = nullptr;
+		Head = 0;
+		Count = 0;
+		Capacity = 0;
+	}
+
+	RingBuffer(RingBuffer&& move) noexcept
+		: AllocatorPolicy(Move(move))
+		, Elements(move.Elements)
+		, Head(move.Head)
+		, Count(move.Count)
+		, Capacity(move.Capacity)
+	{
+		move.Elements = nullptr;
+		move.Head = 0;
+		move.Count = 0;
+		move.Capacity = 0;
+	}
+
+	RingBuffer& operator=(RingBuffer&& move) noexcept
+	{
+		if (&move == this)
+		{
+			return *this;
+		}
+
+		this->~RingBuffer();
+
+		Elements = move.Elements;
+		Head = move.Head;
+		Count = move.Count;
+		Capacity = move.Capacity;
+		AllocatorPolicy::operator=(Move(move));
+
+		move.Elements = nullptr;
+		move.Head = 0;
+		move.Count = 0;
+		move.Capacity = 0;
+
+		return *this;
+	}
+
+	T& operator[](usize index)
+	{
+		CHECK(index < Count);
+		return Elements[(Head + index) & (Capacity - 1)];
+	}
+
+	const T& operator[](usize index) const
+	{
+		CHECK(index < Count);
+		return Elements[(Head + index) & (Capacity - 1)];
+	}
+
+	T& First()
+	{
+		CHECK(!IsEmpty());
+		return (*this)[0];
+	}
+
+	const T& First() const
+	{
+		CHECK(!IsEmpty());
+		return (*this)[0];
+	}
+
+	T& Last()
+	{
+		CHECK(!IsEmpty());
+		return (*this)[Count - 1];
+	}
+
+	const T& Last() const
+	{
+		CHECK(!IsEmpty());
+		return (*this)[Count - 1];
+	}
+
+	usize GetCount() const
+	{
+		return Count;
+	}
+
+	usize GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	ArrayView<T> GetFirstSegment() const
+	{
+		return ArrayView<T>(Elements + Head, GetFirstSegmentCount());
+	}
+
+	ArrayView<T> GetSecondSegment() const
+	{
+		return ArrayView<T>(Elements, Count - GetFirstSegmentCount());
+	}
+
+	void PushBack(const T& newElement)
+	{
+		EmplaceBack(newElement);
+	}
+
+	void PushBack(T&& newElement)
+	{
+		EmplaceBack(Move(newElement));
+	}
+
+	template<typename... Args>
+	void EmplaceBack(Args&&... args)
+	{
+		if (Count == Capacity)
+		{
+			T newElement(Forward<Args>(args)...);
+			Grow(Capacity ? Capacity * 2 : 8);
+			new (&Elements[Count], LuftNewMarker {}) T(Move(newElement));
+		}
+		else
+		{
+			new (&Elements[(Head + Count) & (Capacity - 1)], LuftNewMarker {}) T(Forward<Args>(args)...);
+		}
+		++Count;
+	}
+
+	void PushFront(const T& newElement)
+	{
+		EmplaceFront(newElement);
+	}
+
+	void PushFront(T&& newElement)
+	{
+		EmplaceFront(Move(newElement));
+	}
+
+	template<typename... Args>
+	void EmplaceFront(Args&&... args)
+	{
+		if (Count == Capacity)
+		{
+			T newElement(Forward<Args>(args)...);
+			Grow(Capacity ? Capacity * 2 : 8);
+			Head = Capacity - 1;
+			new (&Elements[Head], LuftNewMarker {}) T(Move(newElement));
+		}
+		else
+		{
+			Head = (Head - 1) & (Capacity - 1);
+			new (&Elements[Head], LuftNewMarker {}) T(Forward<Args>(args)...);
+		}
+		++Count;
+	}
+
+	T PopFront()
+	{
+		CHECK(!IsEmpty());
+
+		T& first = Elements[Head];
+		T popped = MoveIfPossible(first);
+		first.~T();
+
+		Head = (Head + 1) & (Capacity - 1);
+		--Count;
+		return popped;
+	}
+
+	T PopBack()
+	{
+		CHECK(!IsEmpty());
+
+		T& last = Last();
+		T popped = MoveIfPossible(last);
+		last.~T();
+
+		--Count;
+		return popped;
+	}
+
+	void PushBackRange(ArrayView<T> range)
+	{
+		const usize rangeCount = range.GetCount();
+
+		const T* source = range.GetData();
+		const bool isAliased = source >= Elements && source < Elements + Capacity;
+		const usize sourceIndex = isAliased ? (static_cast<usize>(source - Elements) - Head) & (Capacity - 1) : 0;
+
+		Reserve(Count + rangeCount);
+		if (isAliased)
+		{
+			source = Elements + ((Head + sourceIndex) & (Capacity - 1));
+		}
+
+		const usize tail = (Head + Count) & (Capacity - 1);
+		const usize firstCount = Min(rangeCount, Capacity - tail);
+		CopyConstruct(Elements + tail, source, firstCount);
+		CopyConstruct(Elements, source + firstCount, rangeCount - firstCount);
+
+		Count += rangeCount;
+	}
+
+	// Moves the first popCount elements out into uninitialized destination storage.
+	void PopFrontRange(T* destination, usize popCount)
+	{
+		CHECK(popCount <= Count);
+
+		const usize firstCount = Min(popCount, Capacity - Head);
+		Relocate(destination, Elements + Head, firstCount);
+		Relocate(destination + firstCount, Elements, popCount - firstCount);
+
+		Head = (Head + popCount) & (Capacity - 1);
+		Count -= popCount;
+	}
+
+	void DiscardFront(usize discardCount)
+	{
+		CHECK(discardCount <= Count);
+
+		if constexpr (!IsTriviallyDestructible<T>::Value)
+		{
+			for (usize i = 0; i < discardCount; ++i)
+			{
+				(*this)[i].~T();
+			}
+		}
+
+		if (discardCount != 0)
+		{
+			Head = (Head + discardCount) & (Capacity - 1);
+			Count -= discardCount;
+		}
+	}
+
+	void Reserve(usize totalCapacity)
+	{
+		if (totalCapacity > Capacity)
+		{
+			usize newCapacity = Capacity ? Capacity : 8;
+			while (newCapacity < totalCapacity)
+			{
+				newCapacity *= 2;
+			}
+			Grow(newCapacity);
+		}
+	}
+
+	void Clear()
+	{
+		DiscardFront(Count);
+		Head = 0;
+	}
+
+private:
+	usize GetFirstSegmentCount() const
+	{
+		return Min(Count, Capacity - Head);
+	}
+
+	static void CopyConstruct(T* destination, const T* source, usize copyCount)
+	{
+		if constexpr (IsTriviallyCopyable<T>::Value)
+		{
+			if (copyCount != 0)
+			{
+				Platform::MemoryCopy(destination, source, copyCount * sizeof(T));
+			}
+		}
+		else
+		{
+			for (usize i = 0; i < copyCount; ++i)
+			{
+				new (&destination[i], LuftNewMarker {}) T(source[i]);
+			}
+		}
+	}
+
+	static void Relocate(T* destination, T* source, usize relocateCount)
+	{
+		if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			if (relocateCount != 0)
+			{
+				Platform::MemoryCopy(destination, source, relocateCount * sizeof(T));
+			}
+		}
+		else
+		{
+			for (usize i = 0; i < relocateCount; ++i)
+			{
+				new (&destination[i], LuftNewMarker {}) T(MoveIfPossible(source[i]));
+				source[i].~T();
+			}
+		}
+	}
+
+	void Grow(usize totalCapacity)
+	{
+		CHECK(IsPowerOfTwo(totalCapacity) && totalCapacity >= Capacity);
+
+		T* resized = static_cast<T*>(AllocatorPolicy::Allocate(totalCapacity * sizeof(T), alignof(T)));
+
+		const usize firstCount = GetFirstSegmentCount();
+		Relocate(resized, Elements + Head, firstCount);
+		Relocate(resized + firstCount, Elements, Count - firstCount);
+
+		AllocatorPolicy::Deallocate(Elements, Capacity * sizeof(T), alignof(T));
+
+		Elements = resized;
+		Head = 0;
+		Capacity = totalCapacity;
+	}
+
+	T* Elements;
+	usize Head;
+	usize Count;
+	usize Capacity;
+};
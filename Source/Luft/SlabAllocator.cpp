@@ -0,0 +1,101 @@
+#include "SlabAllocator.hpp"
+#include "Error.hpp"
+
+SlabAllocator::SlabAllocator(usize slabSize, Allocator* parent)
+	: FreeLists {}
+	, Slabs(nullptr)
+	, SlabSize(slabSize)
+	, Parent(parent)
+{
+	CHECK(SlabSize >= sizeof(Slab) + MaxSmallSize);
+	CHECK(Parent);
+	CHECK(GetSizeClass(MaxSmallSize) == SizeClassCount - 1);
+	CHECK(GetSizeClassSize(SizeClassCount - 1) == MaxSmallSize);
+}
+
+SlabAllocator::~SlabAllocator()
+{
+	Slab* slab = Slabs;
+	while (slab)
+	{
+		Slab* next = slab->Next;
+		Parent->Deallocate(slab, slab->Size);
+		slab = next;
+	}
+
+	Slabs = nullptr;
+	for (FreeNode*& freeList : FreeLists)
+	{
+		freeList = nullptr;
+	}
+}
+
+void* SlabAllocator::Allocate(usize size, usize alignment)
+{
+	if (size > MaxSmallSize || alignment > DefaultAlignment)
+	{
+		return Parent->Allocate(size, alignment);
+	}
+
+	const usize sizeClass = GetSizeClass(size);
+	if (FreeLists[sizeClass] == nullptr)
+	{
+		AllocateSlab(sizeClass);
+	}
+
+	FreeNode* node = FreeLists[sizeClass];
+	FreeLists[sizeClass] = node->Next;
+	return node;
+}
+
+void SlabAllocator::Deallocate(void* ptr, usize size, usize alignment)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	if (size > MaxSmallSize || alignment > DefaultAlignment)
+	{
+		Parent->Deallocate(ptr, size, alignment);
+		return;
+	}
+
+	const usize sizeClass = GetSizeClass(size);
+	FreeNode* node = static_cast<FreeNode*>(ptr);
+	node->Next = FreeLists[sizeClass];
+	FreeLists[sizeClass] = node;
+}
+
+bool SlabAllocator::TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	CHECK(ptr);
+	CHECK(newSize >= oldSize);
+
+	if (oldSize > MaxSmallSize || alignment > DefaultAlignment)
+	{
+		return Parent->TryExpandInPlace(ptr, oldSize, newSize, alignment);
+	}
+	return newSize <= MaxSmallSize && GetSizeClass(newSize) == GetSizeClass(oldSize);
+}
+
+void SlabAllocator::AllocateSlab(usize sizeClass)
+{
+	Slab* slab = static_cast<Slab*>(Parent->Allocate(SlabSize));
+	slab->Next = Slabs;
+	slab->Size = SlabSize;
+	Slabs = slab;
+
+	const usize objectSize = GetSizeClassSize(sizeClass);
+	const usize objectCount = (SlabSize - sizeof(Slab)) / objectSize;
+	uint8* objects = reinterpret_cast<uint8*>(slab) + sizeof(Slab);
+
+	FreeNode* head = FreeLists[sizeClass];
+	for (usize i = objectCount; i > 0; --i)
+	{
+		FreeNode* node = reinterpret_cast<FreeNode*>(objects + (i - 1) * objectSize);
+		node->Next = head;
+		head = node;
+	}
+	FreeLists[sizeClass] = head;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Base.hpp"
+
+class SlabAllocator final : public Allocator
+{
+public:
+	static constexpr usize SizeClassCount = 16;
+	static constexpr usize MaxSmallSize = 512;
+
+	explicit SlabAllocator(usize slabSize = KB(4), Allocator* parent = &GlobalAllocator::Get());
+	~SlabAllocator() override;
+
+	void* Allocate(usize size, usize alignment = DefaultAlignment) override;
+	void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) override;
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+
+	static usize GetSizeClass(usize size)
+	{
+		if (size <= 128)
+		{
+			return size ? (size - 1) / 16 : 0;
+		}
+		if (size <= 256)
+		{
+			return 8 + (size - 129) / 32;
+		}
+		return 12 + (size - 257) / 64;
+	}
+
+	static usize GetSizeClassSize(usize sizeClass)
+	{
+		if (sizeClass < 8)
+		{
+			return (sizeClass + 1) * 16;
+		}
+		if (sizeClass < 12)
+		{
+			return 128 + (sizeClass - 7) * 32;
+		}
+		return 256 + (sizeClass - 11) * 64;
+	}
+
+private:
+	struct FreeNode
+	{
+		FreeNode* Next;
+	};
+
+	struct Slab
+	{
+		Slab* Next;
+		usize Size;
+	};
+	static_assert(sizeof(Slab) % DefaultAlignment == 0);
+
+	void AllocateSlab(usize sizeClass);
+
+	FreeNode* FreeLists[SizeClassCount];
+	Slab* Slabs;
+
+	usize SlabSize;
+	Allocator* Parent;
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+
+struct SlotMapHandle
+{
+	uint32 Index;
+	uint32 Generation;
+
+	bool operator==(const SlotMapHandle& rhs) const
+	{
+		return Index == rhs.Index && Generation == rhs.Generation;
+	}
+};
+
+// A slot's generation is bumped on insert and on remove, so it is odd while the slot is live and stale handles never match.
+// A zero-initialized handle is never valid.
+template<typename T>
+class SlotMap
+{
+public:
+	explicit SlotMap(Allocator* allocator = &GlobalAllocator::Get())
+		: Values(allocator)
+		, DenseToSlot(allocator)
+		, Slots(allocator)
+		, FreeSlot(InvalidSlot)
+	{
+	}
+
+	T& operator[](SlotMapHandle handle)
+	{
+		return Get(handle);
+	}
+
+	const T& operator[](SlotMapHandle handle) const
+	{
+		return Get(handle);
+	}
+
+	usize GetCount() const
+	{
+		return Values.GetCount();
+	}
+
+	bool IsEmpty() const
+	{
+		return Values.IsEmpty();
+	}
+
+	bool Contains(SlotMapHandle handle) const
+	{
+		return handle.Index < Slots.GetCount() && Slots[handle.Index].Generation == handle.Generation && IsLive(Slots[handle.Index]);
+	}
+
+	T& Get(SlotMapHandle handle)
+	{
+		CHECK(Contains(handle));
+		return Values[Slots[handle.Index].DenseIndex];
+	}
+
+	const T& Get(SlotMapHandle handle) const
+	{
+		CHECK(Contains(handle));
+		return Values[Slots[handle.Index].DenseIndex];
+	}
+
+	T* Find(SlotMapHandle handle)
+	{
+		return Contains(handle) ? &Values[Slots[handle.Index].DenseIndex] : nullptr;
+	}
+
+	const T* Find(SlotMapHandle handle) const
+	{
+		return Contains(handle) ? &Values[Slots[handle.Index].DenseIndex] : nullptr;
+	}
+
+	SlotMapHandle GetHandle(usize denseIndex) const
+	{
+		const uint32 slotIndex = DenseToSlot[denseIndex];
+		return SlotMapHandle { slotIndex, Slots[slotIndex].Generation };
+	}
+
+	ArrayView<T> GetValues() const
+	{
+		return Values;
+	}
+
+	SlotMapHandle Add(const T& value)
+	{
+		return Emplace(value);
+	}
+
+	SlotMapHandle Add(T&& value)
+	{
+		return Emplace(Move(value));
+	}
+
+	template<typename... Args>
+	SlotMapHandle Emplace(Args&&... args)
+	{
+		uint32 slotIndex = FreeSlot;
+		if (slotIndex != InvalidSlot)
+		{
+			FreeSlot = Slots[slotIndex].DenseIndex;
+		}
+		else
+		{
+			CHECK(Slots.GetCount() < InvalidSlot);
+			slotIndex = static_cast<uint32>(Slots.GetCount());
+			Slots.Add(Slot { InvalidSlot, 0 });
+		}
+
+		Slot& slot = Slots[slotIndex];
+		slot.DenseIndex = static_cast<uint32>(Values.GetCount());
+		++slot.Generation;
+
+		Values.Emplace(Forward<Args>(args)...);
+		DenseToSlot.Add(slotIndex);
+
+		return SlotMapHandle { slotIndex, slot.Generation };
+	}
+
+	void Remove(SlotMapHandle handle)
+	{
+		CHECK(Contains(handle));
+
+		Slot& slot = Slots[handle.Index];
+		const uint32 denseIndex = slot.DenseIndex;
+
+		Values.RemoveSwap(denseIndex);
+		DenseToSlot.RemoveSwap(denseIndex);
+		if (denseIndex < DenseToSlot.GetCount())
+		{
+			Slots[DenseToSlot[denseIndex]].DenseIndex = denseIndex;
+		}
+
+		FreeSlotIndex(handle.Index);
+	}
+
+	void Reserve(usize totalCapacity)
+	{
+		Values.Reserve(totalCapacity);
+		DenseToSlot.Reserve(totalCapacity);
+		Slots.Reserve(totalCapacity);
+	}
+
+	void Clear()
+	{
+		for (uint32 slotIndex : DenseToSlot)
+		{
+			FreeSlotIndex(slotIndex);
+		}
+		Values.Clear();
+		DenseToSlot.Clear();
+	}
+
+	ArrayIterator<T> begin()
+	{
+		return Values.begin();
+	}
+
+	ArrayIterator<T> end()
+	{
+		return Values.end();
+	}
+
+	ArrayIterator<const T> begin() const
+	{
+		return Values.begin();
+	}
+
+	ArrayIterator<const T> end() const
+	{
+		return Values.end();
+	}
+
+private:
+	static constexpr uint32 InvalidSlot = ~0u;
+
+	struct Slot
+	{
+		// Index into Values while live, next free slot otherwise.
+		uint32 DenseIndex;
+		uint32 Generation;
+	};
+
+	static bool IsLive(const Slot& slot)
+	{
+		return (slot.Generation & 1) != 0;
+	}
+
+	void FreeSlotIndex(uint32 slotIndex)
+	{
+		Slot& slot = Slots[slotIndex];
+		++slot.Generation;
+		slot.DenseIndex = FreeSlot;
+		FreeSlot = slotIndex;
+	}
+
+	Array<T> Values;
+	Array<uint32> DenseToSlot;
+	Array<Slot> Slots;
+	uint32 FreeSlot;
+};
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+#include "Meta.hpp"
+#include "NoCopy.hpp"
+#include "PlatformCore.hpp"
+
+template<typename SoA>
+class SoAArrayRow
+{
+public:
+	SoAArrayRow(SoA* owner, usize index)
+		: Owner(owner)
+		, Index(index)
+	{
+	}
+
+	template<usize Column>
+	auto& Get() const
+	{
+		return Owner->template GetColumnData<Column>()[Index];
+	}
+
+private:
+	SoA* Owner;
+	usize Index;
+};
+
+template<typename AllocatorPolicy, typename... Fields>
+class BasicSoAArray : public NoCopy, private AllocatorPolicy
+{
+public:
+	static_assert(sizeof...(Fields) > 0);
+
+	static constexpr usize ColumnCount = sizeof...(Fields);
+	static constexpr usize ColumnAlignment = 64;
+
+	template<usize Column>
+	using FieldType = TypeAtType<Column, Fields...>;
+
+	using Row = SoAArrayRow<BasicSoAArray>;
+	using ConstRow = SoAArrayRow<const BasicSoAArray>;
+
+	using AllocatorPolicy::GetAllocator;
+
+	BasicSoAArray()
+		: AllocatorPolicy()
+		, Data(nullptr)
+		, Columns {}
+		, Count(0)
+		, Capacity(0)
+	{
+	}
+
+	explicit BasicSoAArray(Allocator* allocator)
+		: AllocatorPolicy(allocator)
+		, Data(nullptr)
+		, Columns {}
+		, Count(0)
+		, Capacity(0)
+	{
+	}
+
+	~BasicSoAArray()
+	{
+		if (AllocatorPolicy::HasAllocator())
+		{
+			Clear();
+			AllocatorPolicy::Deallocate(Data, GetDataSize(Capacity), ColumnAlignment);
+		}
+		else
+		{
+			CHECK(Data == nullptr);
+		}
+
+		Data = nullptr;
+		Count = 0;
+		Capacity = 0;
+	}
+
+	BasicSoAArray(BasicSoAArray&& move) noexcept
+		: AllocatorPolicy(Move(move))
+		, Data(move.Data)
+		, Count(move.Count)
+		, Capacity(move.Capacity)
+	{
+		Platform::MemoryCopy(Columns, move.Columns, sizeof(Columns));
+
+		move.Data = nullptr;
+		move.Count = 0;
+		move.Capacity = 0;
+	}
+
+	BasicSoAArray& operator=(BasicSoAArray&& move) noexcept
+	{
+		if (&move == this)
+		{
+			return *this;
+		}
+
+		this->~BasicSoAArray();
+
+		Data = move.Data;
+		Platform::MemoryCopy(Columns, move.Columns, sizeof(Columns));
+		Count = move.Count;
+		Capacity = move.Capacity;
+		AllocatorPolicy::operator=(Move(move));
+
+		move.Data = nullptr;
+		move.Count = 0;
+		move.Capacity = 0;
+
+		return *this;
+	}
+
+	Row operator[](usize index)
+	{
+		CHECK(index < Count);
+		return Row(this, index);
+	}
+
+	ConstRow operator[](usize index) const
+	{
+		CHECK(index < Count);
+		return ConstRow(this, index);
+	}
+
+	template<usize Column>
+	FieldType<Column>* GetColumnData()
+	{
+		return static_cast<FieldType<Column>*>(Columns[Column]);
+	}
+
+	template<usize Column>
+	const FieldType<Column>* GetColumnData() const
+	{
+		return static_cast<const FieldType<Column>*>(Columns[Column]);
+	}
+
+	template<usize Column>
+	ArrayView<FieldType<Column>> GetColumn() const
+	{
+		return ArrayView<FieldType<Column>>(GetColumnData<Column>(), Count);
+	}
+
+	usize GetCount() const
+	{
+		return Count;
+	}
+
+	usize GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	template<typename... Args>
+	void Add(Args&&... args)
+	{
+		static_assert(sizeof...(Args) == ColumnCount, "Add takes one value per column!");
+
+		if (Count == Capacity)
+		{
+			Grow(Capacity ? Capacity * 2 : 8);
+		}
+
+		usize column = 0;
+		((new (&static_cast<Fields*>(Columns[column++])[Count], LuftNewMarker {}) Fields(Forward<Args>(args))), ...);
+		++Count;
+	}
+
+	void AddDefaulted(usize newCount)
+	{
+		Reserve(Count + newCount);
+
+		usize column = 0;
+		(ConstructDefaulted(static_cast<Fields*>(Columns[column++]) + Count, newCount), ...);
+		Count += newCount;
+	}
+
+	void Reserve(usize totalCapacity)
+	{
+		if (totalCapacity > Capacity)
+		{
+			Grow(totalCapacity);
+		}
+	}
+
+	void Remove(usize index)
+	{
+		CHECK(index < Count);
+
+		usize column = 0;
+		(RemoveFromColumn(static_cast<Fields*>(Columns[column++]), index, Count), ...);
+		--Count;
+	}
+
+	void RemoveSwap(usize index)
+	{
+		CHECK(index < Count);
+
+		usize column = 0;
+		(RemoveSwapFromColumn(static_cast<Fields*>(Columns[column++]), index, Count), ...);
+		--Count;
+	}
+
+	void Clear()
+	{
+		usize column = 0;
+		(DestroyColumn(static_cast<Fields*>(Columns[column++]), Count), ...);
+		Count = 0;
+	}
+
+private:
+	static usize GetDataSize(usize capacity)
+	{
+		usize size = 0;
+		((size = AlignUp(size, ColumnAlignment) + capacity * sizeof(Fields)), ...);
+		return size;
+	}
+
+	template<typename T>
+	static void ConstructDefaulted(T* elements, usize count)
+	{
+		for (usize i = 0; i < count; ++i)
+		{
+			new (&elements[i], LuftNewMarker {}) T();
+		}
+	}
+
+	template<typename T>
+	static void DestroyColumn(T* elements, usize count)
+	{
+		if constexpr (!IsTriviallyDestructible<T>::Value)
+		{
+			for (usize i = 0; i < count; ++i)
+			{
+				elements[i].~T();
+			}
+		}
+	}
+
+	template<typename T>
+	static void RelocateColumn(T* destination, T* source, usize count)
+	{
+		if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			Platform::MemoryCopy(destination, source, count * sizeof(T));
+		}
+		else
+		{
+			for (usize i = 0; i < count; ++i)
+			{
+				new (&destination[i], LuftNewMarker {}) T(MoveIfPossible(source[i]));
+				source[i].~T();
+			}
+		}
+	}
+
+	template<typename T>
+	static void RemoveFromColumn(T* elements, usize index, usize count)
+	{
+		if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			elements[index].~T();
+			Platform::MemoryMove(elements + index, elements + index + 1, (count - index - 1) * sizeof(T));
+		}
+		else
+		{
+			for (usize i = index; i < count - 1; ++i)
+			{
+				elements[i] = MoveIfPossible(elements[i + 1]);
+			}
+			elements[count - 1].~T();
+		}
+	}
+
+	template<typename T>
+	static void RemoveSwapFromColumn(T* elements, usize index, usize count)
+	{
+		if (index != count - 1)
+		{
+			elements[index] = MoveIfPossible(elements[count - 1]);
+		}
+		elements[count - 1].~T();
+	}
+
+	void Grow(usize totalCapacity)
+	{
+		CHECK(totalCapacity >= Capacity);
+
+		uint8* newData = static_cast<uint8*>(AllocatorPolicy::Allocate(GetDataSize(totalCapacity), ColumnAlignment));
+
+		usize offset = 0;
+		usize column = 0;
+		(
+			(
+				offset = AlignUp(offset, ColumnAlignment),
+				RelocateColumn(reinterpret_cast<Fields*>(newData + offset), static_cast<Fields*>(Columns[column]), Count),
+				Columns[column++] = newData + offset,
+				offset += totalCapacity * sizeof(Fields)
+			), ...
+		);
+
+		AllocatorPolicy::Deallocate(Data, GetDataSize(Capacity), ColumnAlignment);
+
+		Data = newData;
+		Capacity = totalCapacity;
+	}
+
+	uint8* Data;
+	void* Columns[ColumnCount];
+	usize Count;
+	usize Capacity;
+};
+
+template<typename... Fields>
+using SoAArray = BasicSoAArray<DynamicAllocatorPolicy, Fields...>;
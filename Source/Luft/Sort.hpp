@@ -76,15 +76,15 @@ void Sort(T* sort, usize sortCount)
 	Sort(sort, sortCount, [](const T& a, const T& b) { return a < b; });
 }
 
-template<typename T, typename Compare>
-void Sort(Array<T>* sort, const Compare& compare)
+template<typename T, typename AllocatorPolicy, typename Compare>
+void Sort(Array<T, AllocatorPolicy>* sort, const Compare& compare)
 {
 	CHECK(sort);
 	Sort(sort->GetData(), sort->GetCount(), compare);
 }
 
-template<typename T>
-void Sort(Array<T>* sort)
+template<typename T, typename AllocatorPolicy>
+void Sort(Array<T, AllocatorPolicy>* sort)
 {
 	CHECK(sort);
 	Sort(sort->GetData(), sort->GetCount(), [](const T& a, const T& b) { return a < b; });
@@ -131,7 +131,8 @@ void SortStable(T* sort, usize sortCount, Allocator* allocator, const Compare& c
 template<typename T>
 void SortStable(T* sort, usize sortCount)
 {
-	SortStable(sort, sortCount, &GlobalAllocator::Get(), [](const T& a, const T& b) { return a < b; });
+	const ScratchScope scratch;
+	SortStable(sort, sortCount, scratch.Get(), [](const T& a, const T& b) { return a < b; });
 }
 
 template<typename T>
@@ -140,20 +141,20 @@ void SortStable(T* sort, usize sortCount, Allocator* allocator)
 	SortStable(sort, sortCount, allocator, [](const T& a, const T& b) { return a < b; });
 }
 
-template<typename T>
-void SortStable(Array<T>* sort)
+template<typename T, typename AllocatorPolicy>
+void SortStable(Array<T, AllocatorPolicy>* sort)
 {
 	SortStable(sort->GetData(), sort->GetCount());
 }
 
-template<typename T>
-void SortStable(Array<T>* sort, Allocator* allocator)
+template<typename T, typename AllocatorPolicy>
+void SortStable(Array<T, AllocatorPolicy>* sort, Allocator* allocator)
 {
 	SortStable(sort->GetData(), sort->GetCount(), allocator);
 }
 
-template<typename T, typename Compare>
-void SortStable(Array<T>* sort, Allocator* allocator, const Compare& compare)
+template<typename T, typename AllocatorPolicy, typename Compare>
+void SortStable(Array<T, AllocatorPolicy>* sort, Allocator* allocator, const Compare& compare)
 {
 	SortStable(sort->GetData(), sort->GetCount(), allocator, compare);
 }
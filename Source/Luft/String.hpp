@@ -85,54 +85,57 @@ inline StringView operator ""_view(const char* literal, usize length) noexcept
 	return StringView(literal, length);
 }
 
-class String
+template<typename AllocatorPolicy>
+class BasicString : private AllocatorPolicy
 {
 public:
-	String()
-		: Buffer(nullptr)
+	using AllocatorPolicy::GetAllocator;
+
+	BasicString()
+		: AllocatorPolicy()
+		, Buffer(nullptr)
 		, Length(0)
 		, Capacity(0)
-		, Allocator(&GlobalAllocator::Get())
 	{
 	}
 
-	explicit String(Allocator* allocator)
-		: Buffer(nullptr)
+	explicit BasicString(Allocator* allocator)
+		: AllocatorPolicy(allocator)
+		, Buffer(nullptr)
 		, Length(0)
 		, Capacity(0)
-		, Allocator(allocator)
 	{
-		CHECK(Allocator);
+		CHECK(allocator);
 	}
 
-	explicit String(StringView view, Allocator* allocator = &GlobalAllocator::Get())
-		: Buffer(nullptr)
+	explicit BasicString(StringView view, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: AllocatorPolicy(allocator)
+		, Buffer(nullptr)
 		, Length(view.GetLength())
 		, Capacity(view.GetLength())
-		, Allocator(allocator)
 	{
-		CHECK(Allocator);
+		CHECK(allocator);
 
-		Buffer = static_cast<char*>(Allocator->Allocate(Length));
+		Buffer = static_cast<char*>(AllocatorPolicy::Allocate(Length));
 		Platform::MemoryCopy(Buffer, view.GetData(), Length);
 	}
 
-	explicit String(usize capacity, Allocator* allocator = &GlobalAllocator::Get())
-		: Buffer(nullptr)
+	explicit BasicString(usize capacity, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
+		: AllocatorPolicy(allocator)
+		, Buffer(nullptr)
 		, Length(0)
 		, Capacity(capacity)
-		, Allocator(allocator)
 	{
-		CHECK(Allocator);
+		CHECK(allocator);
 
-		Buffer = static_cast<char*>(Allocator->Allocate(Capacity));
+		Buffer = static_cast<char*>(AllocatorPolicy::Allocate(Capacity));
 	}
 
-	~String()
+	~BasicString()
 	{
-		if (Allocator)
+		if (AllocatorPolicy::HasAllocator())
 		{
-			Allocator->Deallocate(Buffer, Capacity);
+			AllocatorPolicy::Deallocate(Buffer, Capacity);
 		}
 		else
 		{
@@ -144,28 +147,28 @@ public:
 		Capacity = 0;
 	}
 
-	String(const String& copy)
-		: Buffer(nullptr)
+	BasicString(const BasicString& copy)
+		: AllocatorPolicy(copy)
+		, Buffer(nullptr)
 		, Length(copy.Length)
 		, Capacity(copy.Capacity)
-		, Allocator(copy.Allocator)
 	{
-		char* newBuffer = static_cast<char*>(Allocator->Allocate(Capacity));
+		char* newBuffer = static_cast<char*>(AllocatorPolicy::Allocate(Capacity));
 		Platform::MemoryCopy(newBuffer, copy.Buffer, Length);
 		Buffer = newBuffer;
 	}
 
-	String& operator=(const String& copy)
+	BasicString& operator=(const BasicString& copy)
 	{
 		if (&copy == this)
 		{
 			return *this;
 		}
 
-		this->~String();
+		this->~BasicString();
 
-		Allocator = copy.Allocator;
-		char* newBuffer = static_cast<char*>(Allocator->Allocate(copy.Capacity));
+		AllocatorPolicy::operator=(copy);
+		char* newBuffer = static_cast<char*>(AllocatorPolicy::Allocate(copy.Capacity));
 		Platform::MemoryCopy(newBuffer, copy.Buffer, copy.Length);
 		Buffer = newBuffer;
 
@@ -175,36 +178,34 @@ public:
 		return *this;
 	}
 
-	String(String&& move) noexcept
-		: Buffer(move.Buffer)
+	BasicString(BasicString&& move) noexcept
+		: AllocatorPolicy(Move(move))
+		, Buffer(move.Buffer)
 		, Length(move.Length)
 		, Capacity(move.Capacity)
-		, Allocator(move.Allocator)
 	{
 		move.Buffer = nullptr;
 		move.Length = 0;
 		move.Capacity = 0;
-		move.Allocator = nullptr;
 	}
 
-	String& operator=(String&& move) noexcept
+	BasicString& operator=(BasicString&& move) noexcept
 	{
 		if (&move == this)
 		{
 			return *this;
 		}
 
-		this->~String();
+		this->~BasicString();
 
 		Buffer = move.Buffer;
 		Length = move.Length;
 		Capacity = move.Capacity;
-		Allocator = move.Allocator;
+		AllocatorPolicy::operator=(Move(move));
 
 		move.Buffer = nullptr;
 		move.Length = 0;
 		move.Capacity = 0;
-		move.Allocator = nullptr;
 
 		return *this;
 	}
@@ -221,7 +222,7 @@ public:
 		return Buffer[index];
 	}
 
-	bool operator==(const String& rhs) const
+	bool operator==(const BasicString& rhs) const
 	{
 		return Platform::StringCompare(Buffer, Length, rhs.Buffer, rhs.Length);
 	}
@@ -231,9 +232,9 @@ public:
 		return StringView(Buffer, Length);
 	}
 
-	static String Empty(Allocator* allocator = &GlobalAllocator::Get())
+	static BasicString Empty(Allocator* allocator = AllocatorPolicy::GetDefaultAllocator())
 	{
-		return String(allocator);
+		return BasicString(allocator);
 	}
 
 	char* GetData() const
@@ -309,7 +310,7 @@ public:
 	{
 		CHECK(Buffer == nullptr);
 		Capacity = capacity;
-		Buffer = static_cast<char*>(Allocator->Allocate(Capacity));
+		Buffer = static_cast<char*>(AllocatorPolicy::Allocate(Capacity));
 	}
 
 	void Clear()
@@ -317,17 +318,17 @@ public:
 		Length = 0;
 	}
 
-	Array<String> Split(char delimiter, Allocator* allocator = &GlobalAllocator::Get()) const
+	Array<BasicString> Split(char delimiter, Allocator* allocator = AllocatorPolicy::GetDefaultAllocator()) const
 	{
 		CHECK(allocator);
 
-		Array<String> parts(allocator);
+		Array<BasicString> parts(allocator);
 		usize startIndex = 0;
 		for (usize index = 0; index <= Length; ++index)
 		{
 			if (index == Length || Buffer[index] == delimiter)
 			{
-				parts.Add(String(StringView(Buffer + startIndex, index - startIndex), allocator));
+				parts.Add(BasicString(StringView(Buffer + startIndex, index - startIndex), allocator));
 				startIndex = index + 1;
 			}
 		}
@@ -340,16 +341,16 @@ private:
 	{
 		CHECK(newCapacity >= Capacity);
 
-		char* resized = static_cast<char*>(Allocator->Allocate(newCapacity));
-		Platform::MemoryCopy(resized, Buffer, Length);
-		Allocator->Deallocate(Buffer, Capacity);
-
-		Buffer = resized;
+		Buffer = static_cast<char*>(AllocatorPolicy::Reallocate(Buffer, Capacity, newCapacity));
 		Capacity = newCapacity;
 	}
 
 	char* Buffer;
 	usize Length;
 	usize Capacity;
-	Allocator* Allocator;
 };
+
+template<typename AllocatorPolicy>
+struct IsTriviallyRelocatable<BasicString<AllocatorPolicy>> : TrueConstant {};
+
+using String = BasicString<DynamicAllocatorPolicy>;
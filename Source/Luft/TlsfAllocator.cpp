@@ -0,0 +1,329 @@
+#include "TlsfAllocator.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+#include "PlatformCore.hpp"
+
+static constexpr usize PoolGranularity = KB(64);
+
+TlsfAllocator::~TlsfAllocator()
+{
+	Pool* pool = Pools;
+	while (pool)
+	{
+		Pool* next = pool->Next;
+		Platform::ReleaseMemory(pool);
+		pool = next;
+	}
+
+	Pools = nullptr;
+	TotalPoolSize = 0;
+	UsedSize = 0;
+	FreeSize = 0;
+	FreeBlockCount = 0;
+}
+
+void* TlsfAllocator::Allocate(usize size, usize alignment)
+{
+	CHECK(IsPowerOfTwo(alignment));
+
+	const usize adjustedSize = AlignUp(Max(size, MinBlockSize), DefaultAlignment);
+	VERIFY(adjustedSize < MaxBlockSize, "Allocation is too large for the TLSF allocator!");
+
+	static constexpr usize minimumGap = BlockOverhead + MinBlockSize;
+	const bool isOverAligned = alignment > DefaultAlignment;
+	const usize searchSize = isOverAligned ? adjustedSize + alignment + minimumGap : adjustedSize;
+
+	BlockHeader* block = FindFreeBlock(searchSize);
+	if (block == nullptr)
+	{
+		AddPool(searchSize);
+		block = FindFreeBlock(searchSize);
+		VERIFY(block, "TLSF pool is too small for the allocation it was added for!");
+	}
+	RemoveFreeBlock(block);
+
+	if (isOverAligned)
+	{
+		const uint64 address = reinterpret_cast<uint64>(block->GetData());
+		uint64 alignedAddress = AlignUp(address, alignment);
+		if (alignedAddress != address && alignedAddress - address < minimumGap)
+		{
+			alignedAddress = AlignUp(address + minimumGap, alignment);
+		}
+
+		const usize gap = alignedAddress - address;
+		if (gap != 0)
+		{
+			BlockHeader* alignedBlock = BlockHeader::FromData(reinterpret_cast<void*>(alignedAddress));
+			alignedBlock->PreviousPhysical = block;
+			alignedBlock->SizeAndFlags = block->GetSize() - gap;
+			alignedBlock->GetNextPhysical()->PreviousPhysical = alignedBlock;
+
+			block->SetSize(gap - BlockOverhead);
+			InsertFreeBlock(block);
+
+			block = alignedBlock;
+		}
+	}
+
+	SplitBlock(block, adjustedSize);
+	block->SetFree(false);
+	UsedSize += block->GetSize();
+
+	return block->GetData();
+}
+
+void TlsfAllocator::Deallocate(void* ptr, usize size, usize alignment)
+{
+	(void)size;
+	(void)alignment;
+
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	BlockHeader* block = BlockHeader::FromData(ptr);
+	CHECK(!block->IsFree());
+
+	UsedSize -= block->GetSize();
+	block->SetFree(true);
+
+	InsertFreeBlock(MergeWithNeighbors(block));
+}
+
+bool TlsfAllocator::TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	(void)oldSize;
+	(void)alignment;
+
+	CHECK(ptr);
+
+	BlockHeader* block = BlockHeader::FromData(ptr);
+	CHECK(!block->IsFree());
+
+	const usize adjustedSize = AlignUp(Max(newSize, MinBlockSize), DefaultAlignment);
+	if (adjustedSize <= block->GetSize())
+	{
+		return true;
+	}
+
+	BlockHeader* next = block->GetNextPhysical();
+	if (!next->IsFree() || block->GetSize() + BlockOverhead + next->GetSize() < adjustedSize)
+	{
+		return false;
+	}
+
+	RemoveFreeBlock(next);
+	UsedSize -= block->GetSize();
+
+	block->SetSize(block->GetSize() + BlockOverhead + next->GetSize());
+	block->GetNextPhysical()->PreviousPhysical = block;
+
+	SplitBlock(block, adjustedSize);
+	UsedSize += block->GetSize();
+
+	return true;
+}
+
+TlsfAllocator::Statistics TlsfAllocator::GetStatistics() const
+{
+	Statistics statistics =
+	{
+		.PoolSize = TotalPoolSize,
+		.UsedSize = UsedSize,
+		.FreeSize = FreeSize,
+		.FreeBlockCount = FreeBlockCount,
+		.LargestFreeBlockSize = 0,
+		.Fragmentation = 0.0f,
+	};
+
+	if (FirstLevelBitmap != 0)
+	{
+		const usize firstLevel = FloorLog2(FirstLevelBitmap);
+		const usize secondLevel = FloorLog2(SecondLevelBitmaps[firstLevel]);
+		for (const BlockHeader* block = FreeLists[firstLevel][secondLevel]; block; block = block->NextFree)
+		{
+			statistics.LargestFreeBlockSize = Max(statistics.LargestFreeBlockSize, block->GetSize());
+		}
+		statistics.Fragmentation = 1.0f - static_cast<float32>(statistics.LargestFreeBlockSize) / static_cast<float32>(FreeSize);
+	}
+
+	return statistics;
+}
+
+void TlsfAllocator::MapSize(usize size, usize* outFirstLevel, usize* outSecondLevel)
+{
+	if (size < SmallBlockSize)
+	{
+		*outFirstLevel = 0;
+		*outSecondLevel = size >> AlignmentLog2;
+	}
+	else
+	{
+		const usize log2 = FloorLog2(size);
+		*outFirstLevel = log2 - (FirstLevelShift - 1);
+		*outSecondLevel = (size >> (log2 - SecondLevelCountLog2)) ^ SecondLevelCount;
+	}
+}
+
+// Any free block in the bin that the rounded size maps to is at least as large as the unrounded size.
+usize TlsfAllocator::RoundUpToBin(usize size)
+{
+	if (size >= SmallBlockSize)
+	{
+		size += (1ull << (FloorLog2(size) - SecondLevelCountLog2)) - 1;
+	}
+	return size;
+}
+
+TlsfAllocator::BlockHeader* TlsfAllocator::FindFreeBlock(usize size)
+{
+	size = RoundUpToBin(size);
+
+	usize firstLevel;
+	usize secondLevel;
+	MapSize(size, &firstLevel, &secondLevel);
+	if (firstLevel >= FirstLevelCount)
+	{
+		return nullptr;
+	}
+
+	uint32 secondLevelMap = SecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+	if (secondLevelMap == 0)
+	{
+		const uint32 firstLevelMap = FirstLevelBitmap & (~0u << (firstLevel + 1));
+		if (firstLevelMap == 0)
+		{
+			return nullptr;
+		}
+
+		firstLevel = CountTrailingZeros(firstLevelMap);
+		secondLevelMap = SecondLevelBitmaps[firstLevel];
+	}
+	secondLevel = CountTrailingZeros(secondLevelMap);
+
+	return FreeLists[firstLevel][secondLevel];
+}
+
+void TlsfAllocator::InsertFreeBlock(BlockHeader* block)
+{
+	usize firstLevel;
+	usize secondLevel;
+	MapSize(block->GetSize(), &firstLevel, &secondLevel);
+	CHECK(firstLevel < FirstLevelCount);
+
+	BlockHeader* head = FreeLists[firstLevel][secondLevel];
+	block->NextFree = head;
+	block->PreviousFree = nullptr;
+	if (head)
+	{
+		head->PreviousFree = block;
+	}
+	FreeLists[firstLevel][secondLevel] = block;
+
+	FirstLevelBitmap |= 1u << firstLevel;
+	SecondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+
+	block->SetFree(true);
+	FreeSize += block->GetSize();
+	++FreeBlockCount;
+}
+
+void TlsfAllocator::RemoveFreeBlock(BlockHeader* block)
+{
+	usize firstLevel;
+	usize secondLevel;
+	MapSize(block->GetSize(), &firstLevel, &secondLevel);
+
+	if (block->PreviousFree)
+	{
+		block->PreviousFree->NextFree = block->NextFree;
+	}
+	else
+	{
+		FreeLists[firstLevel][secondLevel] = block->NextFree;
+		if (block->NextFree == nullptr)
+		{
+			SecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+			if (SecondLevelBitmaps[firstLevel] == 0)
+			{
+				FirstLevelBitmap &= ~(1u << firstLevel);
+			}
+		}
+	}
+	if (block->NextFree)
+	{
+		block->NextFree->PreviousFree = block->PreviousFree;
+	}
+
+	block->SetFree(false);
+	FreeSize -= block->GetSize();
+	--FreeBlockCount;
+}
+
+TlsfAllocator::BlockHeader* TlsfAllocator::MergeWithNeighbors(BlockHeader* block)
+{
+	BlockHeader* previous = block->PreviousPhysical;
+	if (previous && previous->IsFree())
+	{
+		RemoveFreeBlock(previous);
+		previous->SetSize(previous->GetSize() + BlockOverhead + block->GetSize());
+		previous->GetNextPhysical()->PreviousPhysical = previous;
+		block = previous;
+	}
+
+	BlockHeader* next = block->GetNextPhysical();
+	if (next->IsFree())
+	{
+		RemoveFreeBlock(next);
+		block->SetSize(block->GetSize() + BlockOverhead + next->GetSize());
+		block->GetNextPhysical()->PreviousPhysical = block;
+	}
+
+	return block;
+}
+
+void TlsfAllocator::SplitBlock(BlockHeader* block, usize size)
+{
+	const usize blockSize = block->GetSize();
+	if (blockSize < size + BlockOverhead + MinBlockSize)
+	{
+		return;
+	}
+
+	BlockHeader* remainder = reinterpret_cast<BlockHeader*>(block->GetData() + size);
+	remainder->PreviousPhysical = block;
+	remainder->SizeAndFlags = blockSize - size - BlockOverhead;
+	block->SetSize(size);
+
+	BlockHeader* next = remainder->GetNextPhysical();
+	next->PreviousPhysical = remainder;
+
+	InsertFreeBlock(MergeWithNeighbors(remainder));
+}
+
+void TlsfAllocator::AddPool(usize minimumBlockSize)
+{
+	// The pool's free block has to land in the bin FindFreeBlock searches, which for large sizes is wider than the granularity.
+	const usize poolSize = AlignUp(Max(PoolSize, RoundUpToBin(minimumBlockSize) + sizeof(Pool) + 2 * BlockOverhead), PoolGranularity);
+
+	uint8* memory = static_cast<uint8*>(Platform::ReserveMemory(poolSize));
+	Platform::CommitMemory(memory, poolSize);
+
+	Pool* pool = reinterpret_cast<Pool*>(memory);
+	pool->Next = Pools;
+	pool->Size = poolSize;
+	Pools = pool;
+	TotalPoolSize += poolSize;
+
+	BlockHeader* block = reinterpret_cast<BlockHeader*>(memory + sizeof(Pool));
+	block->PreviousPhysical = nullptr;
+	block->SizeAndFlags = poolSize - sizeof(Pool) - 2 * BlockOverhead;
+
+	BlockHeader* sentinel = block->GetNextPhysical();
+	sentinel->PreviousPhysical = block;
+	sentinel->SizeAndFlags = 0;
+
+	InsertFreeBlock(block);
+}
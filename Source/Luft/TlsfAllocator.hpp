@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Base.hpp"
+
+class TlsfAllocator final : public Allocator
+{
+public:
+	struct Statistics
+	{
+		usize PoolSize;
+		usize UsedSize;
+		usize FreeSize;
+		usize FreeBlockCount;
+		usize LargestFreeBlockSize;
+		float32 Fragmentation;
+	};
+
+	constexpr explicit TlsfAllocator(usize poolSize = MB(64))
+		: FirstLevelBitmap(0)
+		, SecondLevelBitmaps {}
+		, FreeLists {}
+		, Pools(nullptr)
+		, PoolSize(poolSize)
+		, TotalPoolSize(0)
+		, UsedSize(0)
+		, FreeSize(0)
+		, FreeBlockCount(0)
+	{
+	}
+
+	~TlsfAllocator() override;
+
+	void* Allocate(usize size, usize alignment = DefaultAlignment) override;
+	void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) override;
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+
+	Statistics GetStatistics() const;
+
+private:
+	static constexpr usize AlignmentLog2 = 4;
+	static constexpr usize SecondLevelCountLog2 = 5;
+	static constexpr usize SecondLevelCount = 1 << SecondLevelCountLog2;
+	static constexpr usize FirstLevelShift = SecondLevelCountLog2 + AlignmentLog2;
+	static constexpr usize FirstLevelMax = 32;
+	static constexpr usize FirstLevelCount = FirstLevelMax - FirstLevelShift + 1;
+
+	static constexpr usize SmallBlockSize = 1 << FirstLevelShift;
+	static constexpr usize MinBlockSize = 16;
+	static constexpr usize MaxBlockSize = 1ull << FirstLevelMax;
+
+	struct BlockHeader
+	{
+		static constexpr usize FreeFlag = 1;
+		static constexpr usize DataOffset = sizeof(BlockHeader*) + sizeof(usize);
+
+		BlockHeader* PreviousPhysical;
+		usize SizeAndFlags;
+
+		BlockHeader* NextFree;
+		BlockHeader* PreviousFree;
+
+		static BlockHeader* FromData(void* data)
+		{
+			return reinterpret_cast<BlockHeader*>(static_cast<uint8*>(data) - DataOffset);
+		}
+
+		uint8* GetData()
+		{
+			return reinterpret_cast<uint8*>(this) + DataOffset;
+		}
+
+		BlockHeader* GetNextPhysical()
+		{
+			return reinterpret_cast<BlockHeader*>(GetData() + GetSize());
+		}
+
+		usize GetSize() const
+		{
+			return SizeAndFlags & ~FreeFlag;
+		}
+
+		void SetSize(usize size)
+		{
+			SizeAndFlags = size | (SizeAndFlags & FreeFlag);
+		}
+
+		bool IsFree() const
+		{
+			return (SizeAndFlags & FreeFlag) != 0;
+		}
+
+		void SetFree(bool free)
+		{
+			SizeAndFlags = free ? (SizeAndFlags | FreeFlag) : (SizeAndFlags & ~FreeFlag);
+		}
+	};
+
+	struct Pool
+	{
+		Pool* Next;
+		usize Size;
+	};
+
+	static constexpr usize BlockOverhead = BlockHeader::DataOffset;
+	static_assert(BlockOverhead == DefaultAlignment);
+	static_assert(sizeof(Pool) == BlockOverhead);
+
+	static void MapSize(usize size, usize* outFirstLevel, usize* outSecondLevel);
+	static usize RoundUpToBin(usize size);
+
+	BlockHeader* FindFreeBlock(usize size);
+	void InsertFreeBlock(BlockHeader* block);
+	void RemoveFreeBlock(BlockHeader* block);
+
+	BlockHeader* MergeWithNeighbors(BlockHeader* block);
+	void SplitBlock(BlockHeader* block, usize size);
+
+	void AddPool(usize minimumBlockSize);
+
+	uint32 FirstLevelBitmap;
+	uint32 SecondLevelBitmaps[FirstLevelCount];
+	BlockHeader* FreeLists[FirstLevelCount][SecondLevelCount];
+
+	Pool* Pools;
+	usize PoolSize;
+
+	usize TotalPoolSize;
+	usize UsedSize;
+	usize FreeSize;
+	usize FreeBlockCount;
+};
+
+#if GLOBAL_ALLOCATOR_TLSF
+TlsfAllocator::Statistics GetGlobalTlsfStatistics();
+#endif
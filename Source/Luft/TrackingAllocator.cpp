@@ -0,0 +1,241 @@
+#include "TrackingAllocator.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+#include "Platform.hpp"
+
+static Mutex InstancesLock;
+static TrackingAllocator* Instances = nullptr;
+
+TrackingAllocator::TrackingAllocator(const char* tag0, Allocator* parent, bool captureCallStacks)
+	: Tag(tag0)
+	, Parent(parent)
+	, CaptureCallStacks(captureCallStacks)
+	, Stats {}
+	, Live(nullptr)
+	, PreviousInstance(nullptr)
+	, NextInstance(nullptr)
+{
+	CHECK(Tag);
+	CHECK(Parent);
+
+	MutexLock lock(&InstancesLock);
+	NextInstance = Instances;
+	if (Instances)
+	{
+		Instances->PreviousInstance = this;
+	}
+	Instances = this;
+}
+
+TrackingAllocator::~TrackingAllocator()
+{
+	if (Stats.LiveCount != 0)
+	{
+		LogLeaks();
+	}
+
+	MutexLock lock(&InstancesLock);
+	if (PreviousInstance)
+	{
+		PreviousInstance->NextInstance = NextInstance;
+	}
+	else
+	{
+		Instances = NextInstance;
+	}
+	if (NextInstance)
+	{
+		NextInstance->PreviousInstance = PreviousInstance;
+	}
+}
+
+void* TrackingAllocator::Allocate(usize size, usize alignment)
+{
+	const usize headerSize = GetHeaderSize(alignment);
+	uint8* block = static_cast<uint8*>(Parent->Allocate(headerSize + size, alignment));
+	void* ptr = block + headerSize;
+
+	Header* header = GetHeader(ptr);
+	header->CallStackCount = CaptureCallStacks ? Platform::CaptureCallStack(header->CallStack, CallStackDepth, 1) : 0;
+	Track(header, size);
+
+	return ptr;
+}
+
+void TrackingAllocator::Deallocate(void* ptr, usize size, usize alignment)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	Header* header = GetHeader(ptr);
+	CHECK(header->Size == size);
+	Untrack(header);
+
+	const usize headerSize = GetHeaderSize(alignment);
+	Parent->Deallocate(static_cast<uint8*>(ptr) - headerSize, headerSize + size, alignment);
+}
+
+bool TrackingAllocator::TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	CHECK(ptr);
+
+	const usize headerSize = GetHeaderSize(alignment);
+	if (!Parent->TryExpandInPlace(static_cast<uint8*>(ptr) - headerSize, headerSize + oldSize, headerSize + newSize, alignment))
+	{
+		return false;
+	}
+
+	Header* header = GetHeader(ptr);
+	CHECK(header->Size == oldSize);
+
+	MutexLock lock(&Lock);
+	header->Size = newSize;
+	AddLiveBytes(newSize - oldSize);
+	return true;
+}
+
+void* TrackingAllocator::Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment)
+{
+	if (ptr == nullptr)
+	{
+		return Allocate(newSize, alignment);
+	}
+
+	Header* header = GetHeader(ptr);
+	CHECK(header->Size == oldSize);
+	{
+		MutexLock lock(&Lock);
+		Unlink(header);
+	}
+
+	const usize headerSize = GetHeaderSize(alignment);
+	uint8* block = static_cast<uint8*>(Parent->Reallocate(static_cast<uint8*>(ptr) - headerSize, headerSize + oldSize, headerSize + newSize, alignment));
+	void* resized = block + headerSize;
+
+	Header* resizedHeader = GetHeader(resized);
+	resizedHeader->Size = newSize;
+	{
+		MutexLock lock(&Lock);
+		Link(resizedHeader);
+		Stats.LiveBytes -= oldSize;
+		AddLiveBytes(newSize);
+	}
+	return resized;
+}
+
+TrackingAllocator::Statistics TrackingAllocator::GetStatistics() const
+{
+	MutexLock lock(&Lock);
+	return Stats;
+}
+
+void TrackingAllocator::LogReport() const
+{
+	const Statistics stats = GetStatistics();
+
+	Platform::LogFormatted("[%s] Live: %llu bytes in %llu allocations, Peak: %llu bytes, Allocations: %llu, Deallocations: %llu\n",
+						   Tag, stats.LiveBytes, stats.LiveCount, stats.PeakBytes, stats.AllocationCount, stats.DeallocationCount);
+	for (usize bucket = 0; bucket < HistogramBucketCount; ++bucket)
+	{
+		if (stats.SizeHistogram[bucket] == 0)
+		{
+			continue;
+		}
+
+		if (bucket == HistogramBucketCount - 1)
+		{
+			Platform::LogFormatted("[%s]     >= %llu: %llu\n", Tag, 1ull << bucket, stats.SizeHistogram[bucket]);
+		}
+		else
+		{
+			Platform::LogFormatted("[%s]     [%llu, %llu): %llu\n", Tag, bucket ? 1ull << bucket : 0ull, 2ull << bucket, stats.SizeHistogram[bucket]);
+		}
+	}
+}
+
+void TrackingAllocator::LogLeaks() const
+{
+	MutexLock lock(&Lock);
+
+	Platform::LogFormatted("[%s] Leaked %llu bytes in %llu allocations!\n", Tag, Stats.LiveBytes, Stats.LiveCount);
+	for (const Header* header = Live; header; header = header->Next)
+	{
+		Platform::LogFormatted("[%s]     %p: %llu bytes\n", Tag, header + 1, header->Size);
+		for (usize frame = 0; frame < header->CallStackCount; ++frame)
+		{
+			Platform::LogFormatted("[%s]         %p\n", Tag, header->CallStack[frame]);
+		}
+	}
+}
+
+void TrackingAllocator::LogAllReports()
+{
+	MutexLock lock(&InstancesLock);
+	for (const TrackingAllocator* instance = Instances; instance; instance = instance->NextInstance)
+	{
+		instance->LogReport();
+	}
+}
+
+usize TrackingAllocator::GetHeaderSize(usize alignment)
+{
+	return AlignUp(sizeof(Header), Max(alignment, DefaultAlignment));
+}
+
+void TrackingAllocator::Track(Header* header, usize size)
+{
+	header->Size = size;
+
+	MutexLock lock(&Lock);
+	Link(header);
+
+	AddLiveBytes(size);
+	++Stats.LiveCount;
+	++Stats.AllocationCount;
+	++Stats.SizeHistogram[size ? Min<usize>(FloorLog2(size), HistogramBucketCount - 1) : 0];
+}
+
+void TrackingAllocator::Untrack(Header* header)
+{
+	MutexLock lock(&Lock);
+	Unlink(header);
+
+	Stats.LiveBytes -= header->Size;
+	--Stats.LiveCount;
+	++Stats.DeallocationCount;
+}
+
+void TrackingAllocator::Link(Header* header)
+{
+	header->Previous = nullptr;
+	header->Next = Live;
+	if (Live)
+	{
+		Live->Previous = header;
+	}
+	Live = header;
+}
+
+void TrackingAllocator::Unlink(Header* header)
+{
+	if (header->Previous)
+	{
+		header->Previous->Next = header->Next;
+	}
+	else
+	{
+		Live = header->Next;
+	}
+	if (header->Next)
+	{
+		header->Next->Previous = header->Previous;
+	}
+}
+
+void TrackingAllocator::AddLiveBytes(usize size)
+{
+	Stats.LiveBytes += size;
+	Stats.PeakBytes = Max(Stats.PeakBytes, Stats.LiveBytes);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Base.hpp"
+#include "Mutex.hpp"
+
+class TrackingAllocator final : public Allocator
+{
+public:
+	static constexpr usize HistogramBucketCount = 32;
+	static constexpr usize CallStackDepth = 8;
+
+	struct Statistics
+	{
+		usize LiveBytes;
+		usize PeakBytes;
+		usize LiveCount;
+		usize AllocationCount;
+		usize DeallocationCount;
+
+		usize SizeHistogram[HistogramBucketCount];
+	};
+
+	explicit TrackingAllocator(const char* tag0, Allocator* parent = &GlobalAllocator::Get(), bool captureCallStacks = false);
+	~TrackingAllocator() override;
+
+	void* Allocate(usize size, usize alignment = DefaultAlignment) override;
+	void Deallocate(void* ptr, usize size, usize alignment = DefaultAlignment) override;
+
+	bool TryExpandInPlace(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+	void* Reallocate(void* ptr, usize oldSize, usize newSize, usize alignment = DefaultAlignment) override;
+
+	const char* GetTag() const
+	{
+		return Tag;
+	}
+
+	Statistics GetStatistics() const;
+
+	void LogReport() const;
+	void LogLeaks() const;
+
+	static void LogAllReports();
+
+private:
+	struct Header
+	{
+		Header* Previous;
+		Header* Next;
+		usize Size;
+		usize CallStackCount;
+		void* CallStack[CallStackDepth];
+	};
+
+	static usize GetHeaderSize(usize alignment);
+
+	static Header* GetHeader(void* ptr)
+	{
+		return reinterpret_cast<Header*>(static_cast<uint8*>(ptr) - sizeof(Header));
+	}
+
+	void Track(Header* header, usize size);
+	void Untrack(Header* header);
+
+	void Link(Header* header);
+	void Unlink(Header* header);
+	void AddLiveBytes(usize size);
+
+	const char* Tag;
+	Allocator* Parent;
+	bool CaptureCallStacks;
+
+	mutable Mutex Lock;
+	Statistics Stats;
+	Header* Live;
+
+	TrackingAllocator* PreviousInstance;
+	TrackingAllocator* NextInstance;
+};
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Base.hpp"
+#include "Error.hpp"
+#include "Math.hpp"
+#include "Meta.hpp"
+#include "NoCopy.hpp"
+#include "PlatformCore.hpp"
+
+template<typename T>
+class VirtualArray : public NoCopy
+{
+public:
+	static constexpr usize CommitGranularity = KB(64);
+
+	explicit VirtualArray(usize maxCount)
+		: Elements(nullptr)
+		, Count(0)
+		, Capacity(0)
+		, CommittedSize(0)
+		, MaxCount(maxCount)
+	{
+		CHECK(MaxCount > 0);
+		Elements = static_cast<T*>(Platform::ReserveMemory(GetReservedSize()));
+	}
+
+	~VirtualArray()
+	{
+		if constexpr (!IsTriviallyDestructible<T>::Value)
+		{
+			for (usize i = 0; i < Count; ++i)
+			{
+				Elements[i].~T();
+			}
+		}
+		Platform::ReleaseMemory(Elements);
+
+		Elements = nullptr;
+		Count = 0;
+		Capacity = 0;
+		CommittedSize = 0;
+		MaxCount = 0;
+	}
+
+	VirtualArray(VirtualArray&& move) noexcept
+		: Elements(move.Elements)
+		, Count(move.Count)
+		, Capacity(move.Capacity)
+		, CommittedSize(move.CommittedSize)
+		, MaxCount(move.MaxCount)
+	{
+		move.Elements = nullptr;
+		move.Count = 0;
+		move.Capacity = 0;
+		move.CommittedSize = 0;
+		move.MaxCount = 0;
+	}
+
+	VirtualArray& operator=(VirtualArray&& move) noexcept
+	{
+		if (&move == this)
+		{
+			return *this;
+		}
+
+		this->~VirtualArray();
+
+		Elements = move.Elements;
+		Count = move.Count;
+		Capacity = move.Capacity;
+		CommittedSize = move.CommittedSize;
+		MaxCount = move.MaxCount;
+
+		move.Elements = nullptr;
+		move.Count = 0;
+		move.Capacity = 0;
+		move.CommittedSize = 0;
+		move.MaxCount = 0;
+
+		return *this;
+	}
+
+	T& operator[](usize index)
+	{
+		CHECK(index < Count);
+		return Elements[index];
+	}
+
+	const T& operator[](usize index) const
+	{
+		CHECK(index < Count);
+		return Elements[index];
+	}
+
+	operator ArrayView<T>() const
+	{
+		return ArrayView<T>(Elements, Count);
+	}
+
+	T& First()
+	{
+		CHECK(!IsEmpty());
+		return Elements[0];
+	}
+
+	const T& First() const
+	{
+		CHECK(!IsEmpty());
+		return Elements[0];
+	}
+
+	T& Last()
+	{
+		CHECK(!IsEmpty());
+		return Elements[Count - 1];
+	}
+
+	const T& Last() const
+	{
+		CHECK(!IsEmpty());
+		return Elements[Count - 1];
+	}
+
+	T* GetData() const
+	{
+		return Elements;
+	}
+
+	usize GetCount() const
+	{
+		return Count;
+	}
+
+	usize GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	usize GetMaxCount() const
+	{
+		return MaxCount;
+	}
+
+	usize GetElementSize() const
+	{
+		return sizeof(T);
+	}
+
+	usize GetDataSize() const
+	{
+		return Count * GetElementSize();
+	}
+
+	bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	void Add(const T& newElement)
+	{
+		Emplace(newElement);
+	}
+
+	void Add(T&& newElement)
+	{
+		Emplace(Move(newElement));
+	}
+
+	template<typename... Args>
+	void Emplace(Args&&... args)
+	{
+		if (Count == Capacity)
+		{
+			Commit(Count + 1);
+		}
+		new (&Elements[Count], LuftNewMarker {}) T(Forward<Args>(args)...);
+		++Count;
+	}
+
+	void AddUninitialized(usize newCount)
+	{
+		if (Count + newCount > Capacity)
+		{
+			Commit(Count + newCount);
+		}
+		Count += newCount;
+	}
+
+	void Reserve(usize totalCapacity)
+	{
+		if (totalCapacity > Capacity)
+		{
+			Commit(totalCapacity);
+		}
+	}
+
+	void Remove(usize index)
+	{
+		CHECK(index < Count);
+
+		if constexpr (IsTriviallyRelocatable<T>::Value)
+		{
+			Elements[index].~T();
+			const usize moveCount = Count - index - 1;
+			Platform::MemoryMove(Elements + index, Elements + index + 1, moveCount * sizeof(T));
+		}
+		else
+		{
+			Elements[index].~T();
+			for (usize i = index; i < Count - 1; ++i)
+			{
+				new (&Elements[i], LuftNewMarker {}) T(MoveIfPossible(Elements[i + 1]));
+				Elements[i + 1].~T();
+			}
+		}
+
+		--Count;
+	}
+
+	void Clear()
+	{
+		if constexpr (!IsTriviallyDestructible<T>::Value)
+		{
+			for (usize i = 0; i < Count; ++i)
+			{
+				Elements[i].~T();
+			}
+		}
+		Count = 0;
+	}
+
+	void ShrinkToFit()
+	{
+		const usize usedSize = AlignUp(Count * sizeof(T), Platform::GetPageSize());
+		if (usedSize < CommittedSize)
+		{
+			Platform::DecommitMemory(reinterpret_cast<uint8*>(Elements) + usedSize, CommittedSize - usedSize);
+			CommittedSize = usedSize;
+			Capacity = CommittedSize / sizeof(T);
+		}
+	}
+
+	ArrayIterator<T> begin()
+	{
+		return ArrayIterator<T>(Elements);
+	}
+
+	ArrayIterator<T> end()
+	{
+		return ArrayIterator<T>(Elements + Count);
+	}
+
+	ArrayIterator<const T> begin() const
+	{
+		return ArrayIterator<const T>(Elements);
+	}
+
+	ArrayIterator<const T> end() const
+	{
+		return ArrayIterator<const T>(Elements + Count);
+	}
+
+private:
+	usize GetReservedSize() const
+	{
+		return AlignUp(MaxCount * sizeof(T), CommitGranularity);
+	}
+
+	void Commit(usize totalCapacity)
+	{
+		VERIFY(totalCapacity <= MaxCount, "Exceeded the reserved size of a virtual array!");
+
+		const usize requiredSize = totalCapacity * sizeof(T);
+		const usize newCommittedSize = Min(AlignUp(Max(requiredSize, CommittedSize * 2), CommitGranularity), GetReservedSize());
+
+		Platform::CommitMemory(reinterpret_cast<uint8*>(Elements) + CommittedSize, newCommittedSize - CommittedSize);
+		CommittedSize = newCommittedSize;
+		Capacity = Min(CommittedSize / sizeof(T), MaxCount);
+	}
+
+	T* Elements;
+	usize Count;
+	usize Capacity;
+	usize CommittedSize;
+	usize MaxCount;
+};
@@ -6,8 +6,10 @@
 
 #include "Allocator.hpp"
 #include "Base.hpp"
+#include "BitArray.hpp"
 #include "Error.hpp"
 #include "HashTable.hpp"
+#include "Mutex.hpp"
 #include "Platform.hpp"
 #include "Windows.hpp"
 
@@ -28,11 +30,11 @@ static uint64 Frequency = 0;
 static bool QuitRequested = false;
 
 static HashTable<uint16, Key> KeyMap(32, &GlobalAllocator::Get());
-static bool KeyPressed[static_cast<usize>(Key::Count)] = {};
-static bool KeyPressedOnce[static_cast<usize>(Key::Count)] = {};
+static BitSet<static_cast<usize>(Key::Count)> KeyPressed;
+static BitSet<static_cast<usize>(Key::Count)> KeyPressedOnce;
 
-static bool MouseButtonPressed[static_cast<usize>(MouseButton::Count)] = {};
-static bool MouseButtonPressedOnce[static_cast<usize>(MouseButton::Count)] = {};
+static BitSet<static_cast<usize>(MouseButton::Count)> MouseButtonPressed;
+static BitSet<static_cast<usize>(MouseButton::Count)> MouseButtonPressedOnce;
 
 static int32 MouseX = 0;
 static int32 MouseY = 0;
@@ -88,6 +90,22 @@ void* Allocate(usize size)
 	return ptr;
 }
 
+void* Reallocate(void* ptr, usize size)
+{
+	const HANDLE heap = GetProcessHeap();
+	CHECK(heap);
+	void* resized = HeapReAlloc(heap, 0, ptr, size);
+	CHECK(resized);
+	return resized;
+}
+
+bool TryReallocateInPlace(void* ptr, usize size)
+{
+	const HANDLE heap = GetProcessHeap();
+	CHECK(heap);
+	return HeapReAlloc(heap, HEAP_REALLOC_IN_PLACE_ONLY, ptr, size) != nullptr;
+}
+
 void Deallocate(void* ptr)
 {
 	const HANDLE heap = GetProcessHeap();
@@ -96,6 +114,66 @@ void Deallocate(void* ptr)
 	CHECK(result);
 }
 
+usize GetPageSize()
+{
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	return systemInfo.dwPageSize;
+}
+
+void* ReserveMemory(usize size)
+{
+	void* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+	VERIFY(ptr, "Failed to reserve virtual memory!");
+	return ptr;
+}
+
+void CommitMemory(void* ptr, usize size)
+{
+	CHECK(ptr);
+	const void* committed = VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE);
+	VERIFY(committed, "Failed to commit virtual memory!");
+}
+
+void DecommitMemory(void* ptr, usize size)
+{
+	CHECK(ptr);
+	const BOOL result = VirtualFree(ptr, size, MEM_DECOMMIT);
+	CHECK(result);
+}
+
+void ReleaseMemory(void* ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	const BOOL result = VirtualFree(ptr, 0, MEM_RELEASE);
+	CHECK(result);
+}
+
+void* AllocateAligned(usize size, usize alignment)
+{
+	CHECK(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	uint8* unaligned = static_cast<uint8*>(Allocate(size + alignment - 1 + sizeof(void*)));
+	const uint64 address = reinterpret_cast<uint64>(unaligned + sizeof(void*));
+	void** aligned = reinterpret_cast<void**>((address + alignment - 1) & ~(alignment - 1));
+	aligned[-1] = unaligned;
+	return aligned;
+}
+
+void DeallocateAligned(void* ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	Deallocate(static_cast<void**>(ptr)[-1]);
+}
+
 bool StringCompare(const char* a, usize aLength, const char* b, usize bLength)
 {
 	const bool areEqual = strncmp(a, b, aLength > bLength ? bLength : aLength) == 0;
@@ -120,10 +198,17 @@ void StringPrint(const char* format0, char* buffer, usize bufferSize, ...)
 	va_end(args);
 }
 
+usize CaptureCallStack(void** frames, usize frameCount, usize skipCount)
+{
+	CHECK(frames);
+	return RtlCaptureStackBackTrace(static_cast<DWORD>(skipCount + 1), static_cast<DWORD>(frameCount), frames, nullptr);
+}
+
 void FatalError(const char* errorMessage0)
 {
 	CHECK(errorMessage0);
-	const Array<wchar_t> errorMessageWide = Windows::UTF8ToWide(StringView(errorMessage0, StringLength(errorMessage0)));
+	const ScratchScope scratch;
+	const Array<wchar_t> errorMessageWide = Windows::UTF8ToWide(StringView(errorMessage0, StringLength(errorMessage0)), scratch.Get());
 	CHECK(MessageBoxW(nullptr, errorMessageWide.GetData(), L"Fatal Error!", MB_ICONERROR));
 	ExitProcess(1);
 }
@@ -131,7 +216,8 @@ void FatalError(const char* errorMessage0)
 void Log(const char* message0)
 {
 	CHECK(message0);
-	const Array<wchar_t> messageWide = Windows::UTF8ToWide(StringView(message0, StringLength(message0)));
+	const ScratchScope scratch;
+	const Array<wchar_t> messageWide = Windows::UTF8ToWide(StringView(message0, StringLength(message0)), scratch.Get());
 	OutputDebugStringW(messageWide.GetData());
 }
 
@@ -177,7 +263,8 @@ uint8* ReadEntireFile(StringView filePath, usize* outSize, Allocator* allocator)
 	CHECK(outSize);
 	CHECK(allocator);
 
-	const Array<wchar_t> filePathWide = Windows::UTF8ToWide(filePath);
+	const ScratchScope scratch(allocator);
+	const Array<wchar_t> filePathWide = Windows::UTF8ToWide(filePath, scratch.Get());
 
 	const uint64 fileAttributes = GetFileAttributesW(filePathWide.GetData());
 	const bool fileExists = fileAttributes != INVALID_FILE_ATTRIBUTES && !(fileAttributes & FILE_ATTRIBUTE_DIRECTORY);
@@ -216,14 +303,8 @@ bool IsQuitRequested()
 
 void ProcessEvents()
 {
-	for (bool& justPressed : KeyPressedOnce)
-	{
-		justPressed = false;
-	}
-	for (bool& justPressed : MouseButtonPressedOnce)
-	{
-		justPressed = false;
-	}
+	KeyPressedOnce.ClearAll();
+	MouseButtonPressedOnce.ClearAll();
 
 	MouseScrollY = 0.0;
 
@@ -263,62 +344,60 @@ static LRESULT CALLBACK WindowProc(HWND window, UINT message, WPARAM wParam, LPA
 	}
 	case WM_KEYDOWN:
 	{
-		const uint16 key = LOWORD(wParam);
-		if (KeyMap.Contains(key))
+		if (const Key* key = KeyMap.Find(LOWORD(wParam)))
 		{
-			const usize keyIndex = static_cast<usize>(KeyMap[key]);
+			const usize keyIndex = static_cast<usize>(*key);
 
-			if (!KeyPressed[keyIndex])
+			if (!KeyPressed.Test(keyIndex))
 			{
-				KeyPressedOnce[keyIndex] = true;
+				KeyPressedOnce.Set(keyIndex);
 			}
-			KeyPressed[keyIndex] = true;
+			KeyPressed.Set(keyIndex);
 		}
 		return 0;
 	}
 	case WM_KEYUP:
 	{
-		const uint16 key = LOWORD(wParam);
-		if (KeyMap.Contains(key))
+		if (const Key* key = KeyMap.Find(LOWORD(wParam)))
 		{
-			const usize keyIndex = static_cast<usize>(KeyMap[key]);
-			KeyPressed[keyIndex] = false;
-			KeyPressedOnce[keyIndex] = false;
+			const usize keyIndex = static_cast<usize>(*key);
+			KeyPressed.Clear(keyIndex);
+			KeyPressedOnce.Clear(keyIndex);
 		}
 		return 0;
 	}
 	case WM_LBUTTONDOWN:
 	{
 		static constexpr usize button = static_cast<usize>(MouseButton::Left);
-		if (!MouseButtonPressed[button])
+		if (!MouseButtonPressed.Test(button))
 		{
-			MouseButtonPressedOnce[button] = true;
+			MouseButtonPressedOnce.Set(button);
 		}
-		MouseButtonPressed[button] = true;
+		MouseButtonPressed.Set(button);
 		return 0;
 	}
 	case WM_LBUTTONUP:
 	{
 		static constexpr usize button = static_cast<usize>(MouseButton::Left);
-		MouseButtonPressedOnce[button] = false;
-		MouseButtonPressed[button] = false;
+		MouseButtonPressedOnce.Clear(button);
+		MouseButtonPressed.Clear(button);
 		return 0;
 	}
 	case WM_RBUTTONDOWN:
 	{
 		static constexpr usize button = static_cast<usize>(MouseButton::Right);
-		if (!MouseButtonPressed[button])
+		if (!MouseButtonPressed.Test(button))
 		{
-			MouseButtonPressedOnce[button] = true;
+			MouseButtonPressedOnce.Set(button);
 		}
-		MouseButtonPressed[button] = true;
+		MouseButtonPressed.Set(button);
 		return 0;
 	}
 	case WM_RBUTTONUP:
 	{
 		static constexpr usize button = static_cast<usize>(MouseButton::Right);
-		MouseButtonPressedOnce[button] = false;
-		MouseButtonPressed[button] = false;
+		MouseButtonPressedOnce.Clear(button);
+		MouseButtonPressed.Clear(button);
 		return 0;
 	}
 	case WM_MOUSEMOVE:
@@ -354,10 +433,10 @@ static LRESULT CALLBACK WindowProc(HWND window, UINT message, WPARAM wParam, LPA
 		MouseScrollY = -GET_WHEEL_DELTA_WPARAM(wParam) / static_cast<float64>(WHEEL_DELTA);
 		return 0;
 	case WM_KILLFOCUS:
-		MemorySet(KeyPressed, false, sizeof(KeyPressed));
-		MemorySet(KeyPressedOnce, false, sizeof(KeyPressedOnce));
-		MemorySet(MouseButtonPressed, false, sizeof(MouseButtonPressed));
-		MemorySet(MouseButtonPressedOnce, false, sizeof(MouseButtonPressedOnce));
+		KeyPressed.ClearAll();
+		KeyPressedOnce.ClearAll();
+		MouseButtonPressed.ClearAll();
+		MouseButtonPressedOnce.ClearAll();
 		MouseX = INT32_MIN;
 		MouseY = INT32_MIN;
 		return 0;
@@ -369,11 +448,13 @@ Window* CreateWindow(StringView title, uint32 drawWidth, uint32 drawHeight)
 {
 	const HMODULE instance = GetModuleHandleW(nullptr);
 
-	String className(&GlobalAllocator::Get());
+	const ScratchScope scratch;
+
+	String className(scratch.Get());
 	className.Append(title);
 	className.Append(" Window Class"_view);
 
-	const Array<wchar_t> classNameWide = Windows::UTF8ToWide(className);
+	const Array<wchar_t> classNameWide = Windows::UTF8ToWide(className, scratch.Get());
 
 	void* native = GlobalAllocator::Get().Allocate(sizeof(HWND) + classNameWide.GetDataSize());
 
@@ -400,7 +481,7 @@ Window* CreateWindow(StringView title, uint32 drawWidth, uint32 drawHeight)
 	RECT windowRectangle = { 0, 0, static_cast<int32>(drawWidth), static_cast<int32>(drawHeight) };
 	CHECK(AdjustWindowRectExForDpi(&windowRectangle, style, false, exStyle, GetDpiForSystem()));
 
-	const Array<wchar_t> titleWide = Windows::UTF8ToWide(title);
+	const Array<wchar_t> titleWide = Windows::UTF8ToWide(title, scratch.Get());
 	const HWND window = CreateWindowExW(exStyle, windowClass.lpszClassName, titleWide.GetData(), style,
 										0, 0, windowRectangle.right - windowRectangle.left, windowRectangle.bottom - windowRectangle.top,
 										nullptr, nullptr, instance, nullptr);
@@ -443,7 +524,8 @@ void ShowWindow(const Window* window, bool maximized)
 
 void SetWindowTitle(const Window* window, StringView title)
 {
-	const Array<wchar_t> titleWide = Windows::UTF8ToWide(title);
+	const ScratchScope scratch;
+	const Array<wchar_t> titleWide = Windows::UTF8ToWide(title, scratch.Get());
 	CHECK(SetWindowTextW(GET_NATIVE_WINDOW(window), titleWide.GetData()));
 }
 
@@ -455,25 +537,25 @@ bool IsWindowFocused(const Window* window)
 bool IsKeyPressed(Key key)
 {
 	CHECK(key != Key::Count);
-	return KeyPressed[static_cast<usize>(key)];
+	return KeyPressed.Test(static_cast<usize>(key));
 }
 
 bool IsKeyPressedOnce(Key key)
 {
 	CHECK(key != Key::Count);
-	return KeyPressedOnce[static_cast<usize>(key)];
+	return KeyPressedOnce.Test(static_cast<usize>(key));
 }
 
 bool IsMouseButtonPressed(MouseButton button)
 {
 	CHECK(button != MouseButton::Count);
-	return MouseButtonPressed[static_cast<usize>(button)];
+	return MouseButtonPressed.Test(static_cast<usize>(button));
 }
 
 bool IsMouseButtonPressedOnce(MouseButton button)
 {
 	CHECK(button != MouseButton::Count);
-	return MouseButtonPressedOnce[static_cast<usize>(button)];
+	return MouseButtonPressedOnce.Test(static_cast<usize>(button));
 }
 
 int32 GetMouseX()
@@ -549,6 +631,23 @@ void InstallResizeHandler(ResizeHandler handler)
 
 }
 
+static_assert(sizeof(SRWLOCK) == sizeof(void*));
+
+void Mutex::Lock()
+{
+	AcquireSRWLockExclusive(reinterpret_cast<SRWLOCK*>(&Native));
+}
+
+void Mutex::Unlock()
+{
+	ReleaseSRWLockExclusive(reinterpret_cast<SRWLOCK*>(&Native));
+}
+
+bool Mutex::TryLock()
+{
+	return TryAcquireSRWLockExclusive(reinterpret_cast<SRWLOCK*>(&Native));
+}
+
 extern void Start();
 
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)